@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Leaderboard.hpp"
+#include "League.hpp"
+
+namespace CatanRanker {
+
+/// \brief Result of a benchmark at one number of games.
+struct Measurement {
+  std::string name;
+
+  int64_t number_of_games{0};
+
+  /// \brief Number of operations performed by each repetition, such as the
+  /// number of games parsed or the number of rows written.
+  uint64_t operations{0};
+
+  int64_t repetitions{0};
+
+  double seconds{0.0};
+
+  uint64_t allocations{0};
+
+  double operations_per_second() const noexcept {
+    return seconds > 0.0 ? operations * repetitions / seconds : 0.0;
+  }
+
+  double allocations_per_operation() const noexcept {
+    return operations > 0 ?
+               static_cast<double>(allocations) / (operations * repetitions) :
+               0.0;
+  }
+};
+
+/// \brief Prevent the compiler from optimizing away the computation of a value
+/// that is otherwise unused.
+template <typename Type>
+inline void keep(const Type& value) noexcept {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+/// \brief Redirects the standard output to nowhere while it exists, so that the
+/// messages of the measured code do not flood the console or skew the timings.
+class Silence {
+public:
+  Silence() noexcept : buffer_(std::cout.rdbuf(nullptr)) {}
+
+  ~Silence() noexcept {
+    std::cout.clear();
+    std::cout.rdbuf(buffer_);
+  }
+
+  Silence(const Silence&) = delete;
+
+  Silence& operator=(const Silence&) = delete;
+
+private:
+  std::streambuf* buffer_;
+};
+
+/// \brief Minimum duration over which a benchmark is repeated so that short
+/// benchmarks are not dominated by timer resolution.
+constexpr const double MinimumBenchmarkSeconds{0.2};
+
+/// \brief Measure a function that returns the number of operations that it
+/// performed. The function is repeated until the minimum duration is reached.
+template <typename Function>
+Measurement measure(const std::string& name, const int64_t number_of_games,
+                    const Function& function) {
+  Measurement measurement;
+  measurement.name = name;
+  measurement.number_of_games = number_of_games;
+  const Silence silence;
+  while (measurement.seconds < MinimumBenchmarkSeconds) {
+    const uint64_t allocations{Allocations::total().allocations};
+    const std::chrono::steady_clock::time_point begin{
+        std::chrono::steady_clock::now()};
+    measurement.operations = function();
+    measurement.seconds += std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - begin)
+                               .count();
+    measurement.allocations += Allocations::total().allocations - allocations;
+    ++measurement.repetitions;
+  }
+  return measurement;
+}
+
+/// \brief Generate the lines of a games file containing a given number of
+/// games of a synthetic league of 100 players. The games are deterministic.
+inline std::vector<std::string> synthetic_games(const int64_t number_of_games) {
+  LeagueSettings settings;
+  settings.number_of_games = number_of_games;
+  League league{settings};
+  std::vector<std::string> lines;
+  lines.reserve(static_cast<std::size_t>(number_of_games));
+  std::string line;
+  while (!league.done()) {
+    line.clear();
+    league.append_next_game(line);
+    line.pop_back();
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+}  // namespace CatanRanker
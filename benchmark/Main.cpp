@@ -0,0 +1,211 @@
+#include "AllocationHooks.hpp"
+#include "Benchmark.hpp"
+
+namespace CatanRanker {
+
+/// \brief Inputs shared by the benchmarks at one number of games.
+struct Workload {
+  Workload(const int64_t number_of_games,
+           const std::experimental::filesystem::path& directory)
+    : number_of_games(number_of_games), lines(synthetic_games(number_of_games)),
+      games_file(directory / ("games_" + std::to_string(number_of_games)
+                              + ".txt")),
+      data_file(directory / ("data_" + std::to_string(number_of_games)
+                             + ".dat")),
+      leaderboard_directory(
+          directory / ("leaderboard_" + std::to_string(number_of_games))) {
+    const Silence silence;
+    std::experimental::filesystem::create_directories(directory);
+    {
+      std::ofstream stream{games_file};
+      for (const std::string& line : lines) {
+        stream << line << '\n';
+      }
+    }
+    games.emplace(TextFileReader{games_file}, context);
+    players.emplace(games.value(), context);
+  }
+
+  int64_t number_of_games;
+
+  std::vector<std::string> lines;
+
+  std::experimental::filesystem::path games_file;
+
+  std::experimental::filesystem::path data_file;
+
+  std::experimental::filesystem::path leaderboard_directory;
+
+  Context context{Settings{}, Profiler{}, Tracer{}};
+
+  std::optional<Games> games;
+
+  std::optional<Players> players;
+};
+
+/// \brief Benchmarks of the program's components, from the parsing of a single
+/// game to the generation of a whole leaderboard.
+std::vector<Measurement> benchmarks(
+    const Workload& workload, const std::string& filter) {
+  const int64_t size{workload.number_of_games};
+  std::vector<Measurement> measurements;
+  const auto run = [&](const std::string& name, const auto& function) {
+    if (filter.empty() || name.find(filter) != std::string::npos) {
+      measurements.push_back(measure(name, size, function));
+      message(
+          "Benchmarked " + name + " with " + std::to_string(size) + " games.");
+    }
+  };
+  run("Game Parsing", [&]() {
+    // Games are parsed into an arena, as in the Games class.
+    std::pmr::monotonic_buffer_resource arena;
+    for (const std::string& line : workload.lines) {
+      const Game game{line, &arena};
+      keep(game);
+    }
+    return static_cast<uint64_t>(workload.lines.size());
+  });
+  run("Date Parsing", [&]() {
+    for (const std::string& line : workload.lines) {
+      const Date date{line.substr(0, 10)};
+      keep(date);
+    }
+    return static_cast<uint64_t>(workload.lines.size());
+  });
+  run("Elo Rating Update", [&]() {
+    uint64_t count{0};
+    std::map<PlayerName, EloRating, PlayerName::sort> ratings;
+    for (const Game& game : workload.games.value()) {
+      const std::pmr::set<PlayerName, PlayerName::sort>& participants{
+          game.player_names()};
+      std::map<PlayerName, EloRating, PlayerName::sort> previous;
+      for (const PlayerName& participant : participants) {
+        previous.insert({participant, ratings[participant]});
+      }
+      for (const PlayerName& participant : participants) {
+        ratings[participant] = update_elo_rating(participant, game, previous);
+        ++count;
+      }
+    }
+    return count;
+  });
+  run("Players Replay", [&]() {
+    Context context{Settings{}, Profiler{}, Tracer{}};
+    const Players players{workload.games.value(), context};
+    keep(players);
+    return static_cast<uint64_t>(workload.games.value().size());
+  });
+  run("Table Printing", [&]() {
+    Column name{"Name", Column::Alignment::Left};
+    Column rating{"Rating", Column::Alignment::Right};
+    Column points{"Points", Column::Alignment::Right};
+    for (int64_t row = 0; row < size; ++row) {
+      name.add_row(League::player_name(row, size));
+      rating.add_row(1000.0 + row % 997, 4);
+      points.add_row(row);
+    }
+    const Table table{
+        {name, rating, points}
+    };
+    const std::string text{table.print_as_markdown()};
+    keep(text);
+    return static_cast<uint64_t>(size);
+  });
+  run("Real Number Formatting", [&]() {
+    for (int64_t index = 0; index < size; ++index) {
+      const std::string text{real_number_to_string(1000.0 + index * 0.001)};
+      keep(text);
+    }
+    return static_cast<uint64_t>(size);
+  });
+  run("Data File Writing", [&]() {
+    // The history of one player in every game category.
+    const Player& player{*workload.players.value().begin()};
+    uint64_t rows{0};
+    for (const GameCategory game_category : GameCategories) {
+      DataFileWriter{workload.data_file, player[game_category]};
+      rows += player[game_category].size();
+    }
+    return rows;
+  });
+  run("Leaderboard Generation", [&]() {
+    Context context{Settings{}, Profiler{}, Tracer{}};
+    context.settings.generate_plots = false;
+    TaskScheduler scheduler{std::max(
+        static_cast<std::size_t>(std::thread::hardware_concurrency()),
+        std::size_t{1})};
+    const Leaderboard leaderboard{workload.leaderboard_directory,
+                                  workload.games.value(),
+                                  workload.players.value(), context, scheduler};
+    return static_cast<uint64_t>(size);
+  });
+  return measurements;
+}
+
+std::string print(const std::vector<Measurement>& measurements) {
+  Column name{"Benchmark", Column::Alignment::Left};
+  Column games{"Games", Column::Alignment::Right};
+  Column operations{"Operations", Column::Alignment::Right};
+  Column repetitions{"Repetitions", Column::Alignment::Right};
+  Column seconds{"Time per Repetition (s)", Column::Alignment::Right};
+  Column throughput{"Operations per Second", Column::Alignment::Right};
+  Column allocations{"Allocations per Operation", Column::Alignment::Right};
+  for (const Measurement& measurement : measurements) {
+    name.add_row(measurement.name);
+    games.add_row(measurement.number_of_games);
+    operations.add_row(static_cast<int64_t>(measurement.operations));
+    repetitions.add_row(measurement.repetitions);
+    seconds.add_row(measurement.seconds / measurement.repetitions, 4);
+    throughput.add_row(measurement.operations_per_second(), 4);
+    allocations.add_row(measurement.allocations_per_operation(), 4);
+  }
+  const Table table{
+      {name, games, operations, repetitions, seconds, throughput, allocations}
+  };
+  return table.print_as_markdown();
+}
+
+}  // namespace CatanRanker
+
+int main(int argc, char* argv[]) {
+  std::vector<int64_t> sizes{1000, 10000, 100000};
+  std::string filter;
+  std::experimental::filesystem::path directory{
+      std::experimental::filesystem::temp_directory_path()
+      / "catan-ranker-bench"};
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    if (argument == "--sizes" && index + 1 < argc) {
+      sizes.clear();
+      for (const std::string& size :
+           CatanRanker::split(std::string{argv[++index]}, ',')) {
+        const std::optional<int64_t> number{
+            CatanRanker::string_to_integer_number(size)};
+        if (!number.has_value() || number.value() <= 0) {
+          CatanRanker::error("Invalid number of games: " + size);
+        }
+        sizes.push_back(number.value());
+      }
+    } else if (argument == "--filter" && index + 1 < argc) {
+      filter = argv[++index];
+    } else if (argument == "--directory" && index + 1 < argc) {
+      directory = argv[++index];
+    } else {
+      CatanRanker::message(
+          "Usage: " + std::string{argv[0]}
+          + " [--sizes <number>,<number>,...] [--filter <name>] [--directory "
+            "<path>]");
+      return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+  std::vector<CatanRanker::Measurement> measurements;
+  for (const int64_t size : sizes) {
+    const CatanRanker::Workload workload{size, directory};
+    const std::vector<CatanRanker::Measurement> results{
+        CatanRanker::benchmarks(workload, filter)};
+    measurements.insert(measurements.end(), results.cbegin(), results.cend());
+  }
+  CatanRanker::message(CatanRanker::print(measurements));
+  std::experimental::filesystem::remove_all(directory);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,347 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace CatanRanker {
+
+/// \brief Parameters of a synthetic league.
+struct LeagueSettings {
+  int64_t number_of_games{1000};
+
+  int64_t number_of_players{100};
+
+  /// \brief Seed of the random number generator. The same settings always
+  /// generate the same games.
+  uint64_t seed{1};
+
+  /// \brief Year of the first game. The games are spread evenly from January
+  /// 1st of this year to December 31st of the last year.
+  int64_t first_year{2010};
+
+  int64_t number_of_years{10};
+
+  /// \brief Exponent of the Zipf distribution of the activity of the players.
+  /// The Nth most active player plays about N^exponent times fewer games than
+  /// the most active player.
+  double activity_exponent{1.0};
+};
+
+/// \brief Generator of a synthetic league of Catan games in the games file
+/// format. Each player has a hidden skill, which determines how well the player
+/// tends to perform, and an activity, which determines how often the player
+/// takes part in a game. The random number generator and the distributions are
+/// implemented here rather than taken from the standard library so that a seed
+/// generates the same games on every platform.
+class League {
+public:
+  League(const LeagueSettings& settings) : settings_(settings) {
+    if (settings_.number_of_players < 8) {
+      error("A league must have at least 8 players so that every table size "
+            "can be generated.");
+    }
+    if (settings_.number_of_games < 0 || settings_.number_of_years <= 0) {
+      error("A league must have a non-negative number of games over a positive "
+            "number of years.");
+    }
+    state_ = settings_.seed;
+    std::vector<int64_t> activity_ranks(settings_.number_of_players);
+    std::iota(activity_ranks.begin(), activity_ranks.end(), 1);
+    // Shuffle the activity ranks so that activity and skill are independent.
+    for (int64_t index = settings_.number_of_players - 1; index > 0; --index) {
+      std::swap(
+          activity_ranks[index], activity_ranks[uniform_integer(0, index)]);
+    }
+    std::vector<double> activities;
+    for (int64_t index = 0; index < settings_.number_of_players; ++index) {
+      names_.push_back(player_name(index, settings_.number_of_players));
+      skills_.push_back(normal());
+      activities.push_back(std::pow(static_cast<double>(activity_ranks[index]),
+                                    -settings_.activity_exponent));
+    }
+    initialize_activity_table(activities);
+    first_day_ = days_from_civil(settings_.first_year, 1, 1);
+    number_of_days_ =
+        days_from_civil(settings_.first_year + settings_.number_of_years, 1, 1)
+        - first_day_;
+  }
+
+  /// \brief Name of the player with a given index in a league with a given
+  /// number of players. Player names only contain letters, so the index is
+  /// written in base 26.
+  static std::string player_name(
+      int64_t index, const int64_t number_of_players) noexcept {
+    std::string name{"Player"};
+    for (int64_t remaining = std::max(number_of_players - 1, int64_t{1});
+         remaining > 0; remaining /= 26) {
+      name += static_cast<char>('a' + index % 26);
+      index /= 26;
+    }
+    return name;
+  }
+
+  /// \brief Whether every game has been generated.
+  bool done() const noexcept {
+    return game_index_ >= settings_.number_of_games;
+  }
+
+  /// \brief Append the next game, followed by a line break, to a text.
+  void append_next_game(std::string& text) noexcept {
+    append_date(text, first_day_ + game_index_ * number_of_days_
+                                       / std::max(settings_.number_of_games,
+                                                  int64_t{1}));
+    const int64_t winning_points{weighted(WinningPointsWeights) + 10};
+    text += " : ";
+    append_integer(text, winning_points);
+    text += " : ";
+    const int64_t number_of_players{weighted(TableSizeWeights) + 3};
+    // Pick distinct players according to their activity and rank them by their
+    // performance in this game, which is their skill plus some luck.
+    std::array<std::pair<double, int64_t>, 8> table;
+    for (int64_t seat = 0; seat < number_of_players; ++seat) {
+      int64_t player;
+      do {
+        player = active_player();
+      } while (std::any_of(table.cbegin(), table.cbegin() + seat,
+                           [player](const std::pair<double, int64_t>& other) {
+                             return other.second == player;
+                           }));
+      table[seat] = {skills_[player] + LuckDeviation * normal(), player};
+    }
+    sort_descending(table, number_of_players);
+    std::array<int64_t, 8> points;
+    points[0] = winning_points;
+    for (int64_t seat = 1; seat < number_of_players; ++seat) {
+      points[seat] = uniform_integer(2, winning_points - 1);
+    }
+    sort_descending(points, number_of_players);
+    // In 5+ player games, the runner-up sometimes ties or passes the winner
+    // during the special build phase, in which case the winner is marked.
+    const bool special_first_place{
+        number_of_players >= 5 && uniform() < SpecialFirstPlaceProbability};
+    if (special_first_place) {
+      points[1] = winning_points + uniform_integer(0, 1);
+    }
+    for (int64_t seat = 0; seat < number_of_players; ++seat) {
+      if (seat > 0) {
+        text += " , ";
+      }
+      text += names_[table[seat].second];
+      text += ' ';
+      append_integer(text, points[seat]);
+      if (seat == 0 && special_first_place) {
+        text += '*';
+      }
+    }
+    text += '\n';
+    ++game_index_;
+  }
+
+private:
+  /// \brief Relative frequencies of the table sizes from 3 to 8 players.
+  static constexpr std::array<double, 6> TableSizeWeights{
+      0.25, 0.35, 0.15, 0.15, 0.05, 0.05};
+
+  /// \brief Relative frequencies of the winning points from 10 to 14.
+  static constexpr std::array<double, 5> WinningPointsWeights{
+      0.60, 0.10, 0.15, 0.10, 0.05};
+
+  /// \brief Standard deviation of the luck of a player in a game, relative to
+  /// the standard deviation of the skills of the players.
+  static constexpr double LuckDeviation{1.5};
+
+  static constexpr double SpecialFirstPlaceProbability{0.05};
+
+  static constexpr double Pi{3.14159265358979323846};
+
+  LeagueSettings settings_;
+
+  uint64_t state_{0};
+
+  std::optional<double> spare_normal_;
+
+  std::vector<std::string> names_;
+
+  std::vector<double> skills_;
+
+  /// \brief Alias table of the activities of the players, which is used to
+  /// pick a player in constant time regardless of the number of players.
+  std::vector<double> activity_thresholds_;
+
+  std::vector<int64_t> activity_aliases_;
+
+  int64_t first_day_{0};
+
+  int64_t number_of_days_{0};
+
+  int64_t game_index_{0};
+
+  /// \brief Next random 64-bit integer, using the SplitMix64 generator.
+  uint64_t next() noexcept {
+    uint64_t value{state_ += 0x9E3779B97F4A7C15ULL};
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+  }
+
+  /// \brief Random real number uniformly distributed in [0, 1).
+  double uniform() noexcept {
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+  }
+
+  /// \brief Random integer uniformly distributed from minimum to maximum,
+  /// both included.
+  int64_t uniform_integer(
+      const int64_t minimum, const int64_t maximum) noexcept {
+    return minimum
+           + static_cast<int64_t>(
+               uniform() * static_cast<double>(maximum - minimum + 1));
+  }
+
+  /// \brief Random real number with a standard normal distribution, using the
+  /// Box-Muller transform. Each transform yields two independent numbers, so
+  /// the second one is kept for the next call.
+  double normal() noexcept {
+    if (spare_normal_.has_value()) {
+      const double value{spare_normal_.value()};
+      spare_normal_.reset();
+      return value;
+    }
+    const double radius{std::sqrt(-2.0 * std::log(1.0 - uniform()))};
+    const double angle{2.0 * Pi * uniform()};
+    spare_normal_ = radius * std::sin(angle);
+    return radius * std::cos(angle);
+  }
+
+  /// \brief Random index of a list of relative frequencies.
+  template <std::size_t Size>
+  int64_t weighted(const std::array<double, Size>& weights) noexcept {
+    double remaining{uniform()};
+    for (std::size_t index = 0; index + 1 < Size; ++index) {
+      remaining -= weights[index];
+      if (remaining < 0.0) {
+        return static_cast<int64_t>(index);
+      }
+    }
+    return static_cast<int64_t>(Size) - 1;
+  }
+
+  /// \brief Build the alias table of the activities of the players using
+  /// Vose's method. Each entry of the table is picked uniformly, and then
+  /// either its own player or its alias is picked according to its threshold.
+  void initialize_activity_table(const std::vector<double>& activities) {
+    const int64_t size{static_cast<int64_t>(activities.size())};
+    const double total{
+        std::accumulate(activities.cbegin(), activities.cend(), 0.0)};
+    activity_thresholds_.assign(size, 1.0);
+    activity_aliases_.resize(size);
+    std::iota(activity_aliases_.begin(), activity_aliases_.end(), 0);
+    std::vector<double> scaled;
+    std::vector<int64_t> small;
+    std::vector<int64_t> large;
+    for (int64_t index = 0; index < size; ++index) {
+      scaled.push_back(activities[index] * size / total);
+      (scaled.back() < 1.0 ? small : large).push_back(index);
+    }
+    while (!small.empty() && !large.empty()) {
+      const int64_t less{small.back()};
+      small.pop_back();
+      const int64_t more{large.back()};
+      activity_thresholds_[less] = scaled[less];
+      activity_aliases_[less] = more;
+      scaled[more] -= 1.0 - scaled[less];
+      if (scaled[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+  }
+
+  /// \brief Random player, chosen according to the activities of the players.
+  int64_t active_player() noexcept {
+    const double position{
+        uniform() * static_cast<double>(settings_.number_of_players)};
+    const int64_t index{std::min(static_cast<int64_t>(position),
+                                 settings_.number_of_players - 1)};
+    return position - static_cast<double>(index) < activity_thresholds_[index] ?
+               index :
+               activity_aliases_[index];
+  }
+
+  /// \brief Sort the first elements of a small array in descending order using
+  /// an insertion sort.
+  template <typename Type>
+  static void sort_descending(
+      std::array<Type, 8>& values, const int64_t size) noexcept {
+    for (int64_t index = 1; index < size; ++index) {
+      const Type value{values[index]};
+      int64_t position{index};
+      for (; position > 0 && values[position - 1] < value; --position) {
+        values[position] = values[position - 1];
+      }
+      values[position] = value;
+    }
+  }
+
+  static void append_integer(std::string& text, int64_t value) noexcept {
+    char digits[20];
+    int64_t length{0};
+    do {
+      digits[length++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value > 0);
+    while (length > 0) {
+      text += digits[--length];
+    }
+  }
+
+  static void append_padded_integer(
+      std::string& text, const int64_t value, const int64_t width) noexcept {
+    for (int64_t power = 10, digit = 1; digit < width; power *= 10, ++digit) {
+      if (value < power) {
+        text += '0';
+      }
+    }
+    append_integer(text, value);
+  }
+
+  /// \brief Append a date in the YYYY-MM-DD format given as a number of days
+  /// since 1970-01-01.
+  static void append_date(std::string& text, const int64_t days) noexcept {
+    // Inverse of the days_from_civil function.
+    const int64_t shifted{days + 719468};
+    const int64_t era{(shifted >= 0 ? shifted : shifted - 146096) / 146097};
+    const int64_t day_of_era{shifted - era * 146097};
+    const int64_t year_of_era{
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524
+         - day_of_era / 146096)
+        / 365};
+    const int64_t day_of_year{
+        day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100)};
+    const int64_t shifted_month{(5 * day_of_year + 2) / 153};
+    const int64_t day{day_of_year - (153 * shifted_month + 2) / 5 + 1};
+    const int64_t month{shifted_month < 10 ? shifted_month + 3 :
+                                             shifted_month - 9};
+    const int64_t year{year_of_era + era * 400 + (month <= 2 ? 1 : 0)};
+    append_padded_integer(text, year, 4);
+    text += '-';
+    append_padded_integer(text, month, 2);
+    text += '-';
+    append_padded_integer(text, day, 2);
+  }
+
+  /// \brief Number of days since 1970-01-01 of a date in the proleptic
+  /// Gregorian calendar.
+  static int64_t days_from_civil(
+      int64_t year, const int64_t month, const int64_t day) noexcept {
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era{(year >= 0 ? year : year - 399) / 400};
+    const int64_t year_of_era{year - era * 400};
+    const int64_t day_of_year{
+        (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1};
+    const int64_t day_of_era{
+        year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year};
+    return era * 146097 + day_of_era - 719468;
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,107 @@
+#include "League.hpp"
+
+namespace CatanRanker {
+
+namespace GeneratorArguments {
+
+const std::string UsageInformation{"--help"};
+
+const std::string NumberOfGamesKey{"--games"};
+
+const std::string NumberOfPlayersKey{"--players"};
+
+const std::string SeedKey{"--seed"};
+
+const std::string FirstYearKey{"--first-year"};
+
+const std::string NumberOfYearsKey{"--years"};
+
+const std::string ActivityExponentKey{"--activity-exponent"};
+
+const std::string OutputKey{"--output"};
+
+}  // namespace GeneratorArguments
+
+void message_usage_information(const std::string& executable_name) {
+  message("Usage:");
+  message("  " + executable_name + " [" + GeneratorArguments::NumberOfGamesKey
+          + " <number>] [" + GeneratorArguments::NumberOfPlayersKey
+          + " <number>] [" + GeneratorArguments::SeedKey + " <number>] ["
+          + GeneratorArguments::FirstYearKey + " <year>] ["
+          + GeneratorArguments::NumberOfYearsKey + " <number>] ["
+          + GeneratorArguments::ActivityExponentKey + " <number>] ["
+          + GeneratorArguments::OutputKey + " <path>]");
+  message("Writes a synthetic games file to the output path, or to the "
+          "standard output if no output path is given.");
+}
+
+int64_t integer_argument(const std::string& key, const std::string& value) {
+  const std::optional<int64_t> number{string_to_integer_number(value)};
+  if (!number.has_value()) {
+    error("The value of " + key + " must be an integer: " + value);
+  }
+  return number.value();
+}
+
+}  // namespace CatanRanker
+
+int main(int argc, char* argv[]) {
+  namespace Arguments = CatanRanker::GeneratorArguments;
+  CatanRanker::LeagueSettings settings;
+  std::string output;
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    const std::string value{index + 1 < argc ? argv[index + 1] : ""};
+    if (argument == Arguments::NumberOfGamesKey && index + 1 < argc) {
+      settings.number_of_games =
+          CatanRanker::integer_argument(argument, value);
+    } else if (argument == Arguments::NumberOfPlayersKey && index + 1 < argc) {
+      settings.number_of_players =
+          CatanRanker::integer_argument(argument, value);
+    } else if (argument == Arguments::SeedKey && index + 1 < argc) {
+      settings.seed = static_cast<uint64_t>(
+          CatanRanker::integer_argument(argument, value));
+    } else if (argument == Arguments::FirstYearKey && index + 1 < argc) {
+      settings.first_year = CatanRanker::integer_argument(argument, value);
+    } else if (argument == Arguments::NumberOfYearsKey && index + 1 < argc) {
+      settings.number_of_years = CatanRanker::integer_argument(argument, value);
+    } else if (argument == Arguments::ActivityExponentKey && index + 1 < argc) {
+      const std::optional<double> number{
+          CatanRanker::string_to_real_number(value)};
+      if (!number.has_value() || number.value() < 0.0) {
+        CatanRanker::error("The value of " + argument
+                           + " must be a non-negative number: " + value);
+      }
+      settings.activity_exponent = number.value();
+    } else if (argument == Arguments::OutputKey && index + 1 < argc) {
+      output = value;
+    } else {
+      CatanRanker::message_usage_information(argv[0]);
+      return argument == Arguments::UsageInformation ? EXIT_SUCCESS :
+                                                        EXIT_FAILURE;
+    }
+    ++index;
+  }
+  CatanRanker::League league{settings};
+  std::ofstream file;
+  if (!output.empty()) {
+    file.open(output);
+    if (!file.is_open()) {
+      CatanRanker::error("Could not open the file: " + output);
+    }
+  }
+  std::ostream& stream{output.empty() ? std::cout : file};
+  // Games are written in blocks to avoid one write per game.
+  constexpr std::size_t BlockSize{1 << 20};
+  std::string block;
+  block.reserve(BlockSize + 256);
+  while (!league.done()) {
+    league.append_next_game(block);
+    if (block.size() >= BlockSize || league.done()) {
+      stream.write(block.data(), static_cast<std::streamsize>(block.size()));
+      block.clear();
+    }
+  }
+  stream.flush();
+  return EXIT_SUCCESS;
+}
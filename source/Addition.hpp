@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CheckpointFileReader.hpp"
+#include "Instructions.hpp"
+#include "Leaderboard.hpp"
+
+namespace CatanRanker {
+
+/// \brief Adds a game given on the command line to the games file. If the
+/// leaderboard has a checkpoint that matches the games file and the game is
+/// its latest game, the game is applied to the players saved in the checkpoint
+/// and only the leaderboard files that the game changes are updated. The rows
+/// of the game are appended to the data files of its participants, so apart
+/// from checking the fingerprint of the games file, the update does not depend
+/// on the number of games, unless the colors of the players change, in which
+/// case the global data files are rewritten. Otherwise, the leaderboard must
+/// be regenerated from the whole games file.
+class Addition {
+public:
+  Addition(const Instructions& instructions, Context& context) {
+    Game game{instructions.added_game(), &context.arena};
+    const std::experimental::filesystem::path checkpoint_file{
+        instructions.leaderboard_directory() / Path::CheckpointFileName};
+    std::optional<Players> players;
+    const std::string reason{
+        instructions.leaderboard_directory().empty() ?
+            std::string{} :
+            apply(game, checkpoint_file, instructions.games_file(), players,
+                  context)};
+    append_line(instructions.games_file(), instructions.added_game());
+    context.profiler.add_games(1);
+    message("Added the game to the games file: "
+            + instructions.games_file().string());
+    if (instructions.leaderboard_directory().empty()) {
+      return;
+    }
+    if (!reason.empty()) {
+      message("The leaderboard will be regenerated from the games file because "
+              + reason + ".");
+      return;
+    }
+    const bool recolored{players.value().assign_colors()};
+    const Leaderboard leaderboard{instructions.leaderboard_directory(), game,
+                                  players.value(), recolored, context};
+    CheckpointFileWriter{
+        checkpoint_file, FileFingerprint::compute(instructions.games_file()),
+        context.settings, players.value()};
+    incremental_ = true;
+  }
+
+  /// \brief Whether the game was applied to the checkpoint of the leaderboard,
+  /// in which case the leaderboard is up to date. Otherwise, the leaderboard
+  /// must be regenerated from the games file.
+  constexpr bool incremental() const noexcept {
+    return incremental_;
+  }
+
+private:
+  bool incremental_{false};
+
+  /// \brief Restore the players from a checkpoint and apply a game to them.
+  /// Return the reason why this is not possible, or an empty string if the
+  /// game was applied.
+  std::string apply(Game& game,
+                    const std::experimental::filesystem::path& checkpoint_file,
+                    const std::experimental::filesystem::path& games_file,
+                    std::optional<Players>& players, Context& context) const {
+    if (!std::experimental::filesystem::exists(checkpoint_file)) {
+      return "the leaderboard has no checkpoint";
+    }
+    const CheckpointFileReader checkpoint{[&]() {
+      const Profiler::Interval interval{context.profiler, Phase::Read};
+      CATAN_RANKER_TRACE_SPAN(context.tracer, "phase", "Read");
+      return CheckpointFileReader{checkpoint_file};
+    }()};
+    if (!checkpoint.valid()) {
+      return "its checkpoint cannot be read";
+    }
+    if (checkpoint.games_file_fingerprint()
+        != FileFingerprint::compute(games_file)) {
+      return "the games file changed since the checkpoint was written";
+    }
+    if (checkpoint.settings().gnuplot_batch != context.settings.gnuplot_batch
+        || checkpoint.settings().binary_data_files
+               != context.settings.binary_data_files
+        || checkpoint.settings().downsample_plots
+               != context.settings.downsample_plots) {
+      return "it was written with other settings";
+    }
+    const Profiler::Interval interval{context.profiler, Phase::Rate};
+    CATAN_RANKER_TRACE_SPAN(context.tracer, "phase", "Rate");
+    players.emplace(checkpoint.players());
+    for (const Player& player : players.value()) {
+      const std::optional<PlayerProperties>& latest{
+          player.latest_properties(GameCategory::AnyNumberOfPlayers)};
+      if (latest.has_value() && game.date() < latest.value().date()) {
+        return "the game is earlier than its latest game";
+      }
+    }
+    game.set_indices(
+        players.value().number_of_games(GameCategory::AnyNumberOfPlayers),
+        players.value().number_of_games(game.category()));
+    players.value().add(game, context);
+    return {};
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "Allocations.hpp"
+
+// Replacements of the global operator new and operator delete that record every
+// allocation in the Allocations class. This file must be included by exactly
+// one translation unit of an executable. Each block is preceded by a header
+// that stores its size so that freed bytes can be counted. The aligned forms
+// are replaced as well because the default memory resource of the standard
+// library allocates through them. The replacements
+// are not inlined so that the compiler does not mistake the pairing of malloc
+// and free for a mismatch of new and free.
+#ifdef CATAN_RANKER_ALLOCATION_TRACKING
+
+namespace CatanRanker::AllocationHooks {
+
+/// \brief Size of the header that precedes each block. Preserves the default
+/// alignment of the blocks returned by operator new.
+constexpr std::size_t HeaderSize{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+inline void* allocate(const std::size_t size) {
+  void* block{std::malloc(HeaderSize + size)};
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  std::memcpy(block, &size, sizeof(size));
+  Allocations::record_allocation(size);
+  return static_cast<char*>(block) + HeaderSize;
+}
+
+inline void deallocate(void* pointer) noexcept {
+  if (pointer != nullptr) {
+    void* block{static_cast<char*>(pointer) - HeaderSize};
+    std::size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    Allocations::record_deallocation(size);
+    std::free(block);
+  }
+}
+
+/// \brief Size of the header that precedes a block with a given alignment.
+inline std::size_t header_size(const std::size_t alignment) noexcept {
+  return std::max(HeaderSize, alignment);
+}
+
+inline void* allocate(
+    const std::size_t size, const std::align_val_t alignment) {
+  const std::size_t bytes{static_cast<std::size_t>(alignment)};
+  const std::size_t header{header_size(bytes)};
+  // The size passed to aligned_alloc must be a multiple of the alignment.
+  void* block{std::aligned_alloc(
+      bytes, (header + size + bytes - 1) / bytes * bytes)};
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  std::memcpy(block, &size, sizeof(size));
+  Allocations::record_allocation(size);
+  return static_cast<char*>(block) + header;
+}
+
+inline void deallocate(
+    void* pointer, const std::align_val_t alignment) noexcept {
+  if (pointer != nullptr) {
+    void* block{static_cast<char*>(pointer)
+                - header_size(static_cast<std::size_t>(alignment))};
+    std::size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    Allocations::record_deallocation(size);
+    std::free(block);
+  }
+}
+
+}  // namespace CatanRanker::AllocationHooks
+
+__attribute__((noinline)) void* operator new(const std::size_t size) {
+  return CatanRanker::AllocationHooks::allocate(size);
+}
+
+__attribute__((noinline)) void* operator new[](const std::size_t size) {
+  return CatanRanker::AllocationHooks::allocate(size);
+}
+
+__attribute__((noinline)) void* operator new(
+    const std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return CatanRanker::AllocationHooks::allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+__attribute__((noinline)) void* operator new[](
+    const std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return CatanRanker::AllocationHooks::allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+__attribute__((noinline)) void operator delete(void* pointer) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer);
+}
+
+__attribute__((noinline)) void operator delete[](void* pointer) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer);
+}
+
+__attribute__((noinline)) void operator delete(
+    void* pointer, const std::size_t) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer);
+}
+
+__attribute__((noinline)) void operator delete[](
+    void* pointer, const std::size_t) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer);
+}
+
+__attribute__((noinline)) void operator delete(
+    void* pointer, const std::nothrow_t&) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer);
+}
+
+__attribute__((noinline)) void operator delete[](
+    void* pointer, const std::nothrow_t&) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer);
+}
+
+__attribute__((noinline)) void* operator new(
+    const std::size_t size, const std::align_val_t alignment) {
+  return CatanRanker::AllocationHooks::allocate(size, alignment);
+}
+
+__attribute__((noinline)) void* operator new[](
+    const std::size_t size, const std::align_val_t alignment) {
+  return CatanRanker::AllocationHooks::allocate(size, alignment);
+}
+
+__attribute__((noinline)) void* operator new(
+    const std::size_t size, const std::align_val_t alignment,
+    const std::nothrow_t&) noexcept {
+  try {
+    return CatanRanker::AllocationHooks::allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+__attribute__((noinline)) void* operator new[](
+    const std::size_t size, const std::align_val_t alignment,
+    const std::nothrow_t&) noexcept {
+  try {
+    return CatanRanker::AllocationHooks::allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+__attribute__((noinline)) void operator delete(
+    void* pointer, const std::align_val_t alignment) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer, alignment);
+}
+
+__attribute__((noinline)) void operator delete[](
+    void* pointer, const std::align_val_t alignment) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer, alignment);
+}
+
+__attribute__((noinline)) void operator delete(
+    void* pointer, const std::size_t,
+    const std::align_val_t alignment) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer, alignment);
+}
+
+__attribute__((noinline)) void operator delete[](
+    void* pointer, const std::size_t,
+    const std::align_val_t alignment) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer, alignment);
+}
+
+__attribute__((noinline)) void operator delete(
+    void* pointer, const std::align_val_t alignment,
+    const std::nothrow_t&) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer, alignment);
+}
+
+__attribute__((noinline)) void operator delete[](
+    void* pointer, const std::align_val_t alignment,
+    const std::nothrow_t&) noexcept {
+  CatanRanker::AllocationHooks::deallocate(pointer, alignment);
+}
+
+#endif
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace CatanRanker {
+
+/// \brief Accounting of the heap allocations of the program. The counters are
+/// only updated if the program is compiled with allocation tracking, in which
+/// case the global operator new and operator delete are replaced by the
+/// counting versions defined in AllocationHooks.hpp. Each allocation is
+/// attributed to the scope of the thread that makes it, such as a phase of the
+/// profiler, or to scope 0 if the thread is not in any scope.
+class Allocations {
+public:
+  /// \brief Whether the program was compiled with allocation tracking.
+#ifdef CATAN_RANKER_ALLOCATION_TRACKING
+  static constexpr bool Available{true};
+#else
+  static constexpr bool Available{false};
+#endif
+
+  /// \brief Maximum number of scopes, including scope 0.
+  static constexpr std::size_t NumberOfScopes{32};
+
+  /// \brief Allocations made in one scope.
+  struct Statistics {
+    uint64_t allocations{0};
+
+    uint64_t bytes{0};
+
+    /// \brief Highest number of bytes allocated by the whole program and not
+    /// yet freed, observed when an allocation was made in this scope.
+    int64_t peak_live_bytes{0};
+  };
+
+  /// \brief Attributes the allocations of the current thread to a scope from
+  /// its construction to its destruction.
+  class Scope {
+  public:
+    Scope(const std::size_t scope) noexcept : previous_(current_scope()) {
+      current_scope() = scope < NumberOfScopes ? scope : 0;
+    }
+
+    ~Scope() noexcept {
+      current_scope() = previous_;
+    }
+
+    Scope(const Scope&) = delete;
+
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    std::size_t previous_;
+  };
+
+  /// \brief Record an allocation of a number of bytes in the current scope.
+  static void record_allocation(const std::size_t size) noexcept {
+    Counters& counters{scope_counters()[current_scope()]};
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    const int64_t live{
+        live_bytes().fetch_add(
+            static_cast<int64_t>(size), std::memory_order_relaxed)
+        + static_cast<int64_t>(size)};
+    update_maximum(counters.peak_live_bytes, live);
+    update_maximum(peak_live_bytes(), live);
+  }
+
+  /// \brief Record that a number of bytes was freed.
+  static void record_deallocation(const std::size_t size) noexcept {
+    live_bytes().fetch_sub(
+        static_cast<int64_t>(size), std::memory_order_relaxed);
+  }
+
+  /// \brief Allocations made in a scope so far.
+  static Statistics statistics(const std::size_t scope) noexcept {
+    const Counters& counters{scope_counters()[scope]};
+    Statistics statistics;
+    statistics.allocations = counters.allocations.load();
+    statistics.bytes = counters.bytes.load();
+    statistics.peak_live_bytes = counters.peak_live_bytes.load();
+    return statistics;
+  }
+
+  /// \brief Allocations made in every scope so far.
+  static Statistics total() noexcept {
+    Statistics total;
+    for (std::size_t scope = 0; scope < NumberOfScopes; ++scope) {
+      const Statistics statistics{Allocations::statistics(scope)};
+      total.allocations += statistics.allocations;
+      total.bytes += statistics.bytes;
+    }
+    total.peak_live_bytes = peak_live_bytes().load();
+    return total;
+  }
+
+private:
+  struct Counters {
+    std::atomic<uint64_t> allocations{0};
+
+    std::atomic<uint64_t> bytes{0};
+
+    std::atomic<int64_t> peak_live_bytes{0};
+  };
+
+  static std::array<Counters, NumberOfScopes>& scope_counters() noexcept {
+    static std::array<Counters, NumberOfScopes> counters;
+    return counters;
+  }
+
+  static std::atomic<int64_t>& live_bytes() noexcept {
+    static std::atomic<int64_t> bytes{0};
+    return bytes;
+  }
+
+  static std::atomic<int64_t>& peak_live_bytes() noexcept {
+    static std::atomic<int64_t> bytes{0};
+    return bytes;
+  }
+
+  static std::size_t& current_scope() noexcept {
+    static thread_local std::size_t scope{0};
+    return scope;
+  }
+
+  static void update_maximum(
+      std::atomic<int64_t>& maximum, const int64_t value) noexcept {
+    int64_t current{maximum.load(std::memory_order_relaxed)};
+    while (current < value
+           && !maximum.compare_exchange_weak(
+               current, value, std::memory_order_relaxed)) {
+    }
+  }
+};
+
+}  // namespace CatanRanker
@@ -20,18 +20,91 @@ const std::string Description{
 
 }  // namespace Program
 
-/// \brief Print a general-purpose message to the console.
+/// \brief Mutex that serializes console output across threads.
+inline std::mutex& console_mutex() noexcept {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// \brief Levels of detail of the messages printed to the console. Each level
+/// includes the messages of the levels before it.
+enum class LogLevel : int8_t {
+  /// \brief Only warnings.
+  Quiet,
+
+  /// \brief A concise summary of the run.
+  Info,
+
+  /// \brief The results of every player in every game category.
+  Verbose,
+
+  /// \brief Every game.
+  Debug
+};
+
+/// \brief Level of detail of the messages printed to the console by the whole
+/// program.
+inline std::atomic<LogLevel>& log_level() noexcept {
+  static std::atomic<LogLevel> level{LogLevel::Info};
+  return level;
+}
+
+/// \brief Whether messages of a given level are printed to the console.
+inline bool logged(const LogLevel level) noexcept {
+  return level <= log_level().load(std::memory_order_relaxed);
+}
+
+/// \brief Print a line to the console. The console is not flushed, so that
+/// many lines can be printed at little cost.
+inline void print_line(const std::string& text) noexcept {
+  const std::lock_guard<std::mutex> lock{console_mutex()};
+  std::cout << text << '\n';
+}
+
+/// \brief Print a general-purpose message to the console unless the log level
+/// is quiet.
 inline void message(const std::string& text) noexcept {
-  std::cout << text << std::endl;
+  if (logged(LogLevel::Info)) {
+    print_line(text);
+  }
 }
 
-/// \brief Print a warning to the console.
+/// \brief Print a detailed message to the console if the log level is verbose
+/// or higher. The message is a function that returns the text, which is only
+/// called if the message is printed.
+template <typename Function>
+inline void verbose(const Function& text) noexcept {
+  if (logged(LogLevel::Verbose)) {
+    print_line(text());
+  }
+}
+
+/// \brief Print a debugging message to the console if the log level is debug.
+/// The message is a function that returns the text, which is only called if
+/// the message is printed.
+template <typename Function>
+inline void debug(const Function& text) noexcept {
+  if (logged(LogLevel::Debug)) {
+    print_line(text());
+  }
+}
+
+/// \brief Print a warning to the console at any log level.
 inline void warning(const std::string& text) noexcept {
+  const std::lock_guard<std::mutex> lock{console_mutex()};
   std::cout << "Warning: " << text << std::endl;
 }
 
-/// \brief Throw an exception.
+/// \brief Write the buffered console output.
+inline void flush_console() noexcept {
+  const std::lock_guard<std::mutex> lock{console_mutex()};
+  std::cout.flush();
+}
+
+/// \brief Throw an exception. The console is flushed first so that the
+/// messages that precede the error are not lost if the program terminates.
 inline void error(const std::string& text) {
+  flush_console();
   throw std::runtime_error(text);
 }
 
@@ -43,6 +116,26 @@ void create(const std::experimental::filesystem::path& directory) {
   }
 }
 
+/// \brief Append a line to a text file, starting a new line first if the file
+/// does not end with one.
+void append_line(const std::experimental::filesystem::path& path,
+                 const std::string& line) {
+  bool ends_with_newline{true};
+  {
+    std::ifstream stream{path.string(), std::ios::binary | std::ios::ate};
+    if (stream.is_open() && stream.tellg() > 0) {
+      stream.seekg(-1, std::ios::end);
+      ends_with_newline = stream.get() == '\n';
+    }
+  }
+  std::ofstream stream{path.string(), std::ios::app};
+  if (!stream.is_open()) {
+    error("Could not open the file: " + path.string());
+  }
+  stream << (ends_with_newline ? "" : "\n") << line << '\n';
+  stream.flush();
+}
+
 template <typename Type>
 const std::map<Type, std::string> labels;
 
@@ -57,6 +150,14 @@ std::string label(const Type type) noexcept {
   }
 }
 
+template <>
+const std::map<LogLevel, std::string> labels<LogLevel>{
+    {LogLevel::Quiet,   "quiet"  },
+    {LogLevel::Info,    "info"   },
+    {LogLevel::Verbose, "verbose"},
+    {LogLevel::Debug,   "debug"  },
+};
+
 enum class GameCategory : int8_t {
   AnyNumberOfPlayers,
   ThreeToFourPlayers,
@@ -117,14 +218,16 @@ std::string date_and_time(const std::tm* date_and_time) noexcept {
 
 std::string current_local_date_and_time() noexcept {
   const std::time_t number{std::time(0)};
-  const std::tm* current{std::localtime(&number)};
-  return date_and_time(current);
+  std::tm current;
+  localtime_r(&number, &current);
+  return date_and_time(&current);
 }
 
 std::string current_utc_date_and_time() noexcept {
   const std::time_t number{std::time(0)};
-  const std::tm* current{std::gmtime(&number)};
-  return date_and_time(current) + " UTC";
+  std::tm current;
+  gmtime_r(&number, &current);
+  return date_and_time(&current) + " UTC";
 }
 
 }  // namespace CatanRanker
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Instructions.hpp"
+#include "Seasons.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writes the leaderboards of several leagues in one process. The
+/// leagues are listed in a manifest file in which each line contains the path
+/// to the games file of a league followed by the path to the directory in
+/// which its leaderboard is written. Empty lines and lines starting with '#'
+/// are ignored, and relative paths are relative to the manifest file. Each
+/// league has its own context, games, and players, so the leagues are computed
+/// concurrently by the same task scheduler, which also runs the Gnuplot
+/// processes of every league. A league that fails does not stop the others.
+class Batch {
+public:
+  Batch(const Instructions& instructions, TaskScheduler& scheduler) {
+    const std::vector<League> leagues{read(instructions.batch_file())};
+    message("Read " + std::to_string(leagues.size())
+            + " leagues from the batch file: "
+            + instructions.batch_file().string());
+    // Each league only waits for the league that started as many leagues
+    // before it as there are threads, which bounds the number of leagues in
+    // memory at once.
+    const std::size_t number_of_threads{
+        static_cast<std::size_t>(instructions.number_of_threads())};
+    TaskGraph graph;
+    for (std::size_t index = 0; index < leagues.size(); ++index) {
+      std::vector<std::size_t> dependencies;
+      if (index >= number_of_threads) {
+        dependencies.push_back(index - number_of_threads);
+      }
+      graph.add(
+          [&, index]() {
+            try {
+              write(leagues[index], instructions, scheduler);
+              message("Wrote the leaderboard of the league to: "
+                      + leagues[index].leaderboard_directory.string());
+            } catch (const std::exception& exception) {
+              ++number_of_failures_;
+              warning("The leaderboard of the league "
+                      + leagues[index].games_file.string()
+                      + " could not be written: " + exception.what());
+            }
+          },
+          dependencies);
+    }
+    graph.run(scheduler);
+    message("Wrote the leaderboards of "
+            + std::to_string(leagues.size() - number_of_failures_) + " of "
+            + std::to_string(leagues.size()) + " leagues.");
+  }
+
+  /// \brief Number of leagues whose leaderboard could not be written.
+  std::size_t number_of_failures() const noexcept {
+    return number_of_failures_;
+  }
+
+private:
+  struct League {
+    std::experimental::filesystem::path games_file;
+
+    std::experimental::filesystem::path leaderboard_directory;
+  };
+
+  std::atomic<std::size_t> number_of_failures_{0};
+
+  static std::vector<League> read(
+      const std::experimental::filesystem::path& batch_file) {
+    const TextFileReader file{batch_file};
+    const std::experimental::filesystem::path base{batch_file.parent_path()};
+    std::vector<League> leagues;
+    std::size_t line_number{0};
+    for (const std::string& line : file) {
+      ++line_number;
+      const std::vector<std::string> words{split_by_whitespace(line)};
+      if (words.empty() || words.front().front() == '#') {
+        continue;
+      }
+      if (words.size() != 2) {
+        error("Line " + std::to_string(line_number) + " of the batch file "
+              + batch_file.string()
+              + " is not a games file followed by a leaderboard directory: "
+              + line);
+      }
+      leagues.push_back({resolve(base, words[0]), resolve(base, words[1])});
+    }
+    if (leagues.empty()) {
+      error("The batch file " + batch_file.string() + " lists no leagues.");
+    }
+    return leagues;
+  }
+
+  /// \brief Resolve a path given in the batch file against the directory of
+  /// the batch file unless it is absolute. Appending an absolute path to a
+  /// directory would not replace the directory.
+  static std::experimental::filesystem::path resolve(
+      const std::experimental::filesystem::path& base,
+      const std::experimental::filesystem::path& path) noexcept {
+    return path.is_relative() ? base / path : path;
+  }
+
+  /// \brief Compute the players of a league and write its leaderboard, its
+  /// checkpoint, and its seasons. Each league has its own context so that its
+  /// games and players are allocated from its own arena, which is released
+  /// once the league is written.
+  static void write(const League& league, const Instructions& instructions,
+                    TaskScheduler& scheduler) {
+    Context context{instructions.settings(), Profiler{false}, Tracer{false}};
+    const TextFileReader file{league.games_file};
+    const Games games{file, context};
+    const std::experimental::filesystem::path streaming_directory{
+        instructions.streaming() ? league.leaderboard_directory :
+                                   std::experimental::filesystem::path{}};
+    const Players players{games, context, streaming_directory};
+    const Leaderboard leaderboard{
+        league.leaderboard_directory, games, players, context, scheduler};
+    CheckpointFileWriter{
+        league.leaderboard_directory / Path::CheckpointFileName,
+        FileFingerprint::compute(league.games_file), context.settings,
+        players};
+    if (!instructions.seasons().empty()) {
+      const Seasons seasons{SeasonSchedule{instructions.seasons()}, games,
+                            context, scheduler, streaming_directory};
+      seasons.write(league.leaderboard_directory, context, scheduler);
+    }
+  }
+};
+
+}  // namespace CatanRanker
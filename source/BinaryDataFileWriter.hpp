@@ -0,0 +1,76 @@
+#pragma once
+
+#include "FileWriter.hpp"
+#include "PlayerProperties.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writer of player data files in Gnuplot's native binary format. Each
+/// game is one record with the same 17 columns as the text data files written
+/// by the DataFileWriter class, so the same column numbers can be used in
+/// Gnuplot files. The date is stored as the integer YYYYMMDD and percentages
+/// are stored from 0 to 100. The file has no header: Gnuplot reads it with the
+/// clause returned by the gnuplot_clause() function.
+class BinaryDataFileWriter : public FileWriter {
+public:
+  BinaryDataFileWriter(const std::experimental::filesystem::path& path,
+                       const std::vector<PlayerProperties>& history) noexcept
+    : FileWriter(path) {
+    std::string bytes;
+    bytes.reserve(history.size() * RecordSize);
+    for (const PlayerProperties& properties : history) {
+      bytes += record(properties);
+    }
+    if (stream_.is_open()) {
+      stream_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+  }
+
+  /// \brief Number of bytes of each record.
+  static constexpr std::size_t RecordSize{17 * 8};
+
+  /// \brief Clause that tells Gnuplot how to read a binary data file.
+  static std::string gnuplot_clause() noexcept {
+    return "binary format=\"%5int64%12float64\"";
+  }
+
+  /// \brief Record of a binary data file corresponding to one game.
+  static std::string record(const PlayerProperties& properties) noexcept {
+    std::string bytes;
+    bytes.reserve(RecordSize);
+    append<int64_t>(bytes, properties.game_number());
+    append<int64_t>(bytes, properties.game_category_game_number());
+    append<int64_t>(bytes, properties.player_game_number());
+    append<int64_t>(bytes, properties.player_game_category_game_number());
+    append<int64_t>(bytes, properties.date().year() * 10000
+                               + properties.date().month_number() * 100
+                               + properties.date().day_number());
+    const double first{properties.place_percentage({1}).value() * 100.0};
+    const double second{properties.place_percentage({2}).value() * 100.0};
+    const double third{properties.place_percentage({3}).value() * 100.0};
+    append<double>(bytes, properties.average_elo_rating().value());
+    append<double>(bytes, properties.elo_rating().value());
+    append<double>(bytes, properties.average_points_per_game());
+    append<double>(bytes, first);
+    append<double>(bytes, second);
+    append<double>(bytes, third);
+    append<double>(bytes, first + second);
+    append<double>(bytes, first + second + third);
+    append<double>(bytes, properties.recent_average_points_per_game());
+    append<double>(
+        bytes, properties.recent_first_place_percentage().value() * 100.0);
+    append<double>(bytes, properties.recent_elo_rating_change());
+    append<double>(bytes, properties.exponential_average_points_per_game());
+    return bytes;
+  }
+
+private:
+  template <typename Type>
+  static void append(std::string& bytes, const Type value) noexcept {
+    char buffer[sizeof(Type)];
+    std::memcpy(buffer, &value, sizeof(Type));
+    bytes.append(buffer, sizeof(Type));
+  }
+};
+
+}  // namespace CatanRanker
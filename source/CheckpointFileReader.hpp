@@ -0,0 +1,219 @@
+#pragma once
+
+#include "CheckpointFileWriter.hpp"
+#include "TextFileReader.hpp"
+
+namespace CatanRanker {
+
+/// \brief Reader of a checkpoint written by the CheckpointFileWriter class. A
+/// checkpoint that cannot be read, for example because it was written by
+/// another version of the program, is not valid rather than an error, since
+/// the leaderboard can always be regenerated from the games file instead.
+class CheckpointFileReader : public TextFileReader {
+public:
+  CheckpointFileReader(const std::experimental::filesystem::path& path) noexcept
+    : TextFileReader(path) {
+    try {
+      read();
+      valid_ = true;
+    } catch (const std::exception&) {
+      players_.clear();
+    }
+  }
+
+  constexpr bool valid() const noexcept {
+    return valid_;
+  }
+
+  /// \brief Fingerprint of the games file from which the checkpoint was
+  /// computed.
+  constexpr const FileFingerprint& games_file_fingerprint() const noexcept {
+    return games_file_fingerprint_;
+  }
+
+  /// \brief Settings with which the leaderboard files were written. Only the
+  /// settings that change the contents of the files are saved.
+  constexpr const Settings& settings() const noexcept {
+    return settings_;
+  }
+
+  /// \brief Players saved in the checkpoint, without their histories.
+  const std::vector<Player>& players() const noexcept {
+    return players_;
+  }
+
+private:
+  bool valid_{false};
+
+  FileFingerprint games_file_fingerprint_;
+
+  Settings settings_;
+
+  std::vector<Player> players_;
+
+  /// \brief State of the player whose lines are being read.
+  struct PlayerState {
+    PlayerName name;
+
+    std::string color;
+
+    std::map<GameCategory, std::optional<PlayerProperties>> latest{
+        {GameCategory::AnyNumberOfPlayers,  {}},
+        {GameCategory::ThreeToFourPlayers,  {}},
+        {GameCategory::FiveToSixPlayers,    {}},
+        {GameCategory::SevenToEightPlayers, {}}
+    };
+
+    std::map<GameCategory, Form> forms{
+        {GameCategory::AnyNumberOfPlayers,  {}},
+        {GameCategory::ThreeToFourPlayers,  {}},
+        {GameCategory::FiveToSixPlayers,    {}},
+        {GameCategory::SevenToEightPlayers, {}}
+    };
+
+    std::map<GameCategory, EloRating> lowest_elo_ratings{
+        {GameCategory::AnyNumberOfPlayers,  {}},
+        {GameCategory::ThreeToFourPlayers,  {}},
+        {GameCategory::FiveToSixPlayers,    {}},
+        {GameCategory::SevenToEightPlayers, {}}
+    };
+
+    std::map<GameCategory, EloRating> highest_elo_ratings{
+        {GameCategory::AnyNumberOfPlayers,  {}},
+        {GameCategory::ThreeToFourPlayers,  {}},
+        {GameCategory::FiveToSixPlayers,    {}},
+        {GameCategory::SevenToEightPlayers, {}}
+    };
+  };
+
+  void read() {
+    bool has_games_file{false};
+    bool has_settings{false};
+    std::optional<PlayerState> player;
+    for (const std::string& line : lines_) {
+      const std::vector<std::string> words{split_by_whitespace(line)};
+      if (words.empty() || words.front().front() == '#') {
+        continue;
+      }
+      if (words.front() == "games_file" && words.size() == 3) {
+        games_file_fingerprint_.size = unsigned_integer(words[1]);
+        games_file_fingerprint_.hash = unsigned_integer(words[2]);
+        has_games_file = true;
+      } else if (words.front() == "settings" && words.size() == 4) {
+        settings_.gnuplot_batch = words[1] == "1";
+        settings_.binary_data_files = words[2] == "1";
+        settings_.downsample_plots = words[3] == "1";
+        has_settings = true;
+      } else if (words.front() == "player" && words.size() == 3) {
+        add(player);
+        player.emplace();
+        player.value().name = {words[1]};
+        player.value().color =
+            words[2] != CheckpointFileWriter::NoColor ? words[2] : "";
+      } else if (player.has_value() && words.front() == "form"
+                 && words.size() >= 6) {
+        read_form(words, player.value());
+      } else if (player.has_value() && words.size() >= 13) {
+        read_properties(words, player.value());
+      } else {
+        error("Invalid line in the checkpoint: " + line);
+      }
+    }
+    add(player);
+    if (!has_games_file || !has_settings) {
+      error("The checkpoint is incomplete.");
+    }
+  }
+
+  void add(const std::optional<PlayerState>& player) {
+    if (player.has_value()) {
+      players_.emplace_back(
+          player.value().name, player.value().color, player.value().latest,
+          player.value().forms, player.value().lowest_elo_ratings,
+          player.value().highest_elo_ratings);
+    }
+  }
+
+  /// \brief Read the line of the recent form of a player in a game category,
+  /// in the format of the CheckpointFileWriter class. It precedes the line of
+  /// the state of the player in that game category.
+  void read_form(
+      const std::vector<std::string>& words, PlayerState& player) const {
+    std::vector<Form::Entry> entries;
+    for (std::size_t index = 6; index < words.size(); ++index) {
+      const std::vector<std::string> entry{split(words[index], ':')};
+      if (entry.size() != 3) {
+        error("Invalid form entry in the checkpoint: " + words[index]);
+      }
+      entries.push_back({real(entry[0]), entry[1] == "1", real(entry[2])});
+    }
+    player.forms[game_category(words[1])] = {
+        static_cast<std::size_t>(integer(words[2])), real(words[3]),
+        integer(words[4]), real(words[5]), entries};
+  }
+
+  /// \brief Read the line of the state of a player in a game category, in the
+  /// format of the CheckpointFileWriter class.
+  void read_properties(
+      const std::vector<std::string>& words, PlayerState& player) const {
+    const GameCategory game_category{this->game_category(words[0])};
+    std::map<Place, int64_t, Place::sort> place_counts;
+    for (std::size_t index = 13; index < words.size(); ++index) {
+      const std::vector<std::string> place_and_count{split(words[index], ':')};
+      if (place_and_count.size() != 2) {
+        error("Invalid place count in the checkpoint: " + words[index]);
+      }
+      place_counts.insert(
+          {{static_cast<int8_t>(integer(place_and_count[0]))},
+           integer(place_and_count[1])});
+    }
+    player.lowest_elo_ratings[game_category] = {real(words[1])};
+    player.highest_elo_ratings[game_category] = {real(words[2])};
+    player.latest[game_category] = PlayerProperties{
+        integer(words[3]), integer(words[4]), integer(words[5]),
+        integer(words[6]), Date{words[7]},    real(words[8]),
+        place_counts,      {real(words[9])},  {real(words[10])},
+        real(words[11]),   real(words[12]),   player.forms[game_category]};
+  }
+
+  static GameCategory game_category(const std::string& word) {
+    std::optional<GameCategory> game_category;
+    for (const GameCategory category : GameCategories) {
+      if (word == Path::game_category_file_name(category).string()) {
+        game_category = category;
+      }
+    }
+    if (!game_category.has_value()) {
+      error("Unknown game category in the checkpoint: " + word);
+    }
+    return game_category.value();
+  }
+
+  static int64_t integer(const std::string& word) {
+    const std::optional<int64_t> value{string_to_integer_number(word)};
+    if (!value.has_value()) {
+      error("Invalid integer in the checkpoint: " + word);
+    }
+    return value.value();
+  }
+
+  static uint64_t unsigned_integer(const std::string& word) {
+    uint64_t value{0};
+    const std::from_chars_result result{
+        std::from_chars(word.data(), word.data() + word.size(), value)};
+    if (result.ec != std::errc{} || result.ptr != word.data() + word.size()) {
+      error("Invalid integer in the checkpoint: " + word);
+    }
+    return value;
+  }
+
+  static double real(const std::string& word) {
+    const std::optional<double> value{string_to_real_number(word)};
+    if (!value.has_value()) {
+      error("Invalid number in the checkpoint: " + word);
+    }
+    return value.value();
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Players.hpp"
+#include "Settings.hpp"
+#include "TextFileWriter.hpp"
+
+namespace CatanRanker {
+
+/// \brief Size and 64-bit FNV-1a hash of the contents of a file, which identify
+/// the version of the file from which a checkpoint was computed.
+struct FileFingerprint {
+  uint64_t size{0};
+
+  uint64_t hash{0};
+
+  /// \brief Fingerprint of a file. Zero if the file cannot be read.
+  static FileFingerprint compute(
+      const std::experimental::filesystem::path& path) noexcept {
+    FileFingerprint fingerprint;
+    std::ifstream stream{path.string(), std::ios::binary};
+    if (!stream.is_open()) {
+      return fingerprint;
+    }
+    fingerprint.hash = 14695981039346656037ULL;
+    char buffer[64 * 1024];
+    while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0) {
+      const std::streamsize count{stream.gcount()};
+      for (std::streamsize index = 0; index < count; ++index) {
+        fingerprint.hash ^= static_cast<unsigned char>(buffer[index]);
+        fingerprint.hash *= 1099511628211ULL;
+      }
+      fingerprint.size += static_cast<uint64_t>(count);
+    }
+    return fingerprint;
+  }
+
+  bool operator==(const FileFingerprint& other) const noexcept {
+    return size == other.size && hash == other.hash;
+  }
+
+  bool operator!=(const FileFingerprint& other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+/// \brief Writes the checkpoint of a leaderboard: the state of every player
+/// after the last game, along with the fingerprint of the games file and the
+/// settings from which the leaderboard was written. A game that is later than
+/// every other game can then be applied to the checkpoint and to the files of
+/// the leaderboard without reading the games file. Real numbers are written
+/// with the fewest digits that read back to the same value, so the ratings
+/// computed from a checkpoint are identical to those computed from the games.
+class CheckpointFileWriter : public TextFileWriter {
+public:
+  CheckpointFileWriter(const std::experimental::filesystem::path& path,
+                       const FileFingerprint& games_file_fingerprint,
+                       const Settings& settings,
+                       const Players& players) noexcept
+    : TextFileWriter(path) {
+    std::string text{
+        "# Checkpoint of the leaderboard from which games are added. It is "
+        "rewritten by every run.\ngames_file "};
+    text += std::to_string(games_file_fingerprint.size) + " "
+            + std::to_string(games_file_fingerprint.hash) + "\nsettings "
+            + std::to_string(settings.gnuplot_batch) + " "
+            + std::to_string(settings.binary_data_files) + " "
+            + std::to_string(settings.downsample_plots);
+    for (const Player& player : players) {
+      text += "\nplayer " + player.name().value() + " "
+              + (player.color().empty() ? NoColor : player.color());
+      for (const GameCategory game_category : GameCategories) {
+        const std::optional<PlayerProperties>& latest{
+            player.latest_properties(game_category)};
+        if (latest.has_value()) {
+          text += "\n";
+          append_form(text, game_category, player.form(game_category));
+          text += "\n";
+          append_properties(text, game_category, player, latest.value());
+        }
+      }
+    }
+    line(text);
+  }
+
+  /// \brief Word written in place of the color of a player who has none.
+  static inline const std::string NoColor{"none"};
+
+private:
+  /// \brief Append the line of the state of a player in a game category: the
+  /// game category, the lowest and highest Elo ratings, and the latest
+  /// properties, ending with the number of finishes in each place.
+  static void append_properties(
+      std::string& text, const GameCategory game_category, const Player& player,
+      const PlayerProperties& latest) noexcept {
+    text += Path::game_category_file_name(game_category).string();
+    append_number(text, player.lowest_elo_rating(game_category).value());
+    append_number(text, player.highest_elo_rating(game_category).value());
+    text += " " + std::to_string(latest.game_number()) + " "
+            + std::to_string(latest.game_category_game_number()) + " "
+            + std::to_string(latest.player_game_number()) + " "
+            + std::to_string(latest.player_game_category_game_number()) + " "
+            + latest.date().print();
+    append_number(text, latest.average_points_per_game());
+    append_number(text, latest.elo_rating().value());
+    append_number(text, latest.average_elo_rating().value());
+    append_number(text, latest.total_points());
+    append_number(text, latest.total_elo_rating());
+    for (const std::pair<const Place, int64_t>& place_count :
+         latest.place_counts()) {
+      text += " " + std::to_string(place_count.first.value()) + ":"
+              + std::to_string(place_count.second);
+    }
+  }
+
+  /// \brief Append the line of the recent form of a player in a game category:
+  /// the word "form", the game category, the next slot of the ring buffer, the
+  /// running sums, the moving average, and the games of the ring buffer in the
+  /// order of their slots. The running sums are saved rather than recomputed
+  /// so that they are identical to those obtained from the games.
+  static void append_form(std::string& text, const GameCategory game_category,
+                          const Form& form) noexcept {
+    text += "form " + Path::game_category_file_name(game_category).string()
+            + " " + std::to_string(form.next());
+    append_number(text, form.total_points());
+    text += " " + std::to_string(form.number_of_first_places());
+    append_number(text, form.exponential_average_points());
+    for (std::size_t slot = 0; slot < form.size(); ++slot) {
+      const Form::Entry& entry{form.entry(slot)};
+      append_number(text, entry.points);
+      text += entry.first_place ? ":1:" : ":0:";
+      append_number_digits(text, entry.previous_elo_rating);
+    }
+  }
+
+  /// \brief Append a space and the shortest representation of a real number
+  /// that reads back to the same value.
+  static void append_number(std::string& text, const double value) noexcept {
+    text += ' ';
+    append_number_digits(text, value);
+  }
+
+  /// \brief Append the shortest representation of a real number that reads
+  /// back to the same value, without a leading space.
+  static void append_number_digits(
+      std::string& text, const double value) noexcept {
+    char characters[32];
+    const std::to_chars_result result{
+        std::to_chars(characters, characters + sizeof(characters), value)};
+    text.append(characters, result.ptr);
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Profiler.hpp"
+#include "Settings.hpp"
+#include "Tracer.hpp"
+
+namespace CatanRanker {
+
+/// \brief State shared by every stage of a run: the settings that control how
+/// the leaderboard files are written, the profiler that measures the run, and
+/// the tracer that records its spans, and the arena that backs the games and
+/// player histories of the run. Each run has its own context, so nothing about
+/// a run is global. The context must outlive the games and players of its run.
+struct Context {
+  Settings settings;
+
+  Profiler profiler;
+
+  Tracer tracer;
+
+  /// \brief Monotonic arena from which the games and the player histories
+  /// allocate their nodes. These live until the end of the run, so individual
+  /// deallocations are no-ops and the whole arena is released at once when the
+  /// context is destroyed. The arena is not thread-safe and is only used by the
+  /// single-threaded parsing and rating stages.
+  std::pmr::monotonic_buffer_resource arena;
+};
+
+}  // namespace CatanRanker
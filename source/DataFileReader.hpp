@@ -0,0 +1,85 @@
+#pragma once
+
+#include "TextFileReader.hpp"
+
+namespace CatanRanker {
+
+/// \brief Reader of a player data file written by the DataFileWriter or
+/// DataFileStream classes. Comment lines and blank lines are skipped. The
+/// numeric value of each column of each row is available; columns that are not
+/// numbers, such as the date, have a value of zero. Percentage signs are
+/// ignored.
+class DataFileReader : public TextFileReader {
+public:
+  DataFileReader(const std::experimental::filesystem::path& path) noexcept
+    : TextFileReader(path) {
+    rows_.reserve(lines_.size());
+    values_.reserve(lines_.size());
+    for (std::string& line : lines_) {
+      const std::size_t first{line.find_first_not_of(" \t\r\n")};
+      if (first == std::string::npos || line.front() == '#') {
+        continue;
+      }
+      values_.push_back(parse(line));
+      rows_.push_back(std::move(line));
+    }
+  }
+
+  /// \brief Number of rows of data, excluding comment lines and blank lines.
+  std::size_t number_of_rows() const noexcept {
+    return rows_.size();
+  }
+
+  /// \brief Text of a row of data.
+  const std::string& row(const std::size_t row_index) const noexcept {
+    return rows_[row_index];
+  }
+
+  /// \brief Numeric value of a column of a row of data. Columns are numbered
+  /// from 1, as in Gnuplot.
+  double value(const std::size_t row_index,
+               const std::size_t column_number) const noexcept {
+    const std::vector<double>& values{values_[row_index]};
+    if (column_number >= 1 && column_number <= values.size()) {
+      return values[column_number - 1];
+    } else {
+      return 0.0;
+    }
+  }
+
+private:
+  std::vector<std::string> rows_;
+
+  std::vector<std::vector<double>> values_;
+
+  /// \brief Numeric value of each column of a row. The columns are scanned in
+  /// place and parsed with std::from_chars because data files are read back
+  /// row by row when the leaderboard is updated or downsampled.
+  static std::vector<double> parse(const std::string& line) noexcept {
+    std::vector<double> values;
+    const char* character{line.data()};
+    const char* const end{line.data() + line.size()};
+    while (character < end) {
+      while (character < end
+             && std::isspace(static_cast<unsigned char>(*character))) {
+        ++character;
+      }
+      const char* const begin{character};
+      while (character < end
+             && !std::isspace(static_cast<unsigned char>(*character))) {
+        ++character;
+      }
+      if (character == begin) {
+        break;
+      }
+      const char* const last{character[-1] == '%' ? character - 1 : character};
+      double value{0.0};
+      const std::from_chars_result result{std::from_chars(begin, last, value)};
+      values.push_back(
+          result.ec == std::errc{} && result.ptr == last ? value : 0.0);
+    }
+    return values;
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "BinaryDataFileWriter.hpp"
+#include "DataFileWriter.hpp"
+#include "Path.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writer of player data files one game at a time, in the same format as
+/// the DataFileWriter class. Lines are accumulated in an in-memory spill buffer
+/// and appended to their data files whenever the buffer exceeds its capacity,
+/// so memory usage is bounded regardless of the number of games. Optionally,
+/// the same games are also appended to binary data files in the format of the
+/// BinaryDataFileWriter class.
+class DataFileStream {
+public:
+  DataFileStream(const std::experimental::filesystem::path& base_directory,
+                 const bool binary = false,
+                 const std::size_t capacity = 64 * 1024 * 1024) noexcept
+    : base_directory_(base_directory), binary_(binary), capacity_(capacity) {}
+
+  ~DataFileStream() noexcept {
+    flush();
+    for (const std::experimental::filesystem::path& path : started_paths_) {
+      if (path.extension() != ".bin") {
+        append(path, "\n");
+      }
+    }
+  }
+
+  /// \brief Append a game to a player's data file in a game category.
+  void add(const PlayerName& player_name, const GameCategory game_category,
+           const PlayerProperties& properties) noexcept {
+    std::string& buffer{buffers_[player_name][game_category]};
+    const std::size_t previous_size{buffer.size()};
+    buffer += DataFileWriter::row(properties) + "\n";
+    size_ += buffer.size() - previous_size;
+    if (binary_) {
+      binary_buffers_[player_name][game_category] +=
+          BinaryDataFileWriter::record(properties);
+      size_ += BinaryDataFileWriter::RecordSize;
+    }
+    if (size_ > capacity_) {
+      flush();
+    }
+  }
+
+  /// \brief Append all buffered lines to their data files and empty the spill
+  /// buffer.
+  void flush() noexcept {
+    flush(buffers_, false);
+    flush(binary_buffers_, true);
+    size_ = 0;
+  }
+
+private:
+  std::experimental::filesystem::path base_directory_;
+
+  bool binary_{false};
+
+  std::size_t capacity_;
+
+  std::size_t size_{0};
+
+  std::map<PlayerName, std::map<GameCategory, std::string>, PlayerName::sort>
+      buffers_;
+
+  std::map<PlayerName, std::map<GameCategory, std::string>, PlayerName::sort>
+      binary_buffers_;
+
+  std::set<std::experimental::filesystem::path> started_paths_;
+
+  void flush(std::map<PlayerName, std::map<GameCategory, std::string>,
+                      PlayerName::sort>& buffers,
+             const bool binary) {
+    for (std::pair<const PlayerName, std::map<GameCategory, std::string>>&
+             player_buffers : buffers) {
+      for (std::pair<const GameCategory, std::string>& buffer :
+           player_buffers.second) {
+        if (!buffer.second.empty()) {
+          const std::experimental::filesystem::path path{
+              data_path(player_buffers.first, buffer.first, binary)};
+          if (started_paths_.insert(path).second) {
+            start(player_buffers.first, path, binary);
+          }
+          append(path, buffer.second);
+          buffer.second.clear();
+          buffer.second.shrink_to_fit();
+        }
+      }
+    }
+  }
+
+  std::experimental::filesystem::path data_path(
+      const PlayerName& player_name, const GameCategory game_category,
+      const bool binary) const noexcept {
+    return base_directory_ / player_name.directory_name()
+           / Path::PlayerDataDirectoryName
+           / (binary ? Path::player_binary_data_file_name(game_category) :
+                       Path::player_data_file_name(game_category));
+  }
+
+  /// \brief Create the directories of a data file and write its header line,
+  /// if it is a text data file, replacing any existing data file.
+  void start(const PlayerName& player_name,
+             const std::experimental::filesystem::path& path,
+             const bool binary) const {
+    create(base_directory_);
+    create(base_directory_ / Path::PlayersDirectoryName);
+    create(base_directory_ / player_name.directory_name());
+    create(base_directory_ / player_name.directory_name()
+           / Path::PlayerDataDirectoryName);
+    std::ofstream stream{path.string(), std::ios::trunc | std::ios::binary};
+    if (!stream.is_open()) {
+      error("Could not open the file: " + path.string());
+    }
+    if (!binary) {
+      stream << DataFileWriter::header() << "\n";
+      file_counters().bytes += DataFileWriter::header().size() + 1;
+    }
+    stream.close();
+    ++file_counters().files;
+    std::experimental::filesystem::permissions(
+        path, std::experimental::filesystem::perms::owner_read
+                  | std::experimental::filesystem::perms::owner_write
+                  | std::experimental::filesystem::perms::group_read
+                  | std::experimental::filesystem::perms::others_read);
+  }
+
+  void append(const std::experimental::filesystem::path& path,
+              const std::string& text) const {
+    std::ofstream stream{path.string(), std::ios::app | std::ios::binary};
+    if (!stream.is_open()) {
+      error("Could not open the file: " + path.string());
+    }
+    stream << text;
+    file_counters().bytes += text.size();
+  }
+};
+
+}  // namespace CatanRanker
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Table.hpp"
+#include "PlayerProperties.hpp"
 #include "TextFileWriter.hpp"
 
 namespace CatanRanker {
@@ -8,11 +8,49 @@ namespace CatanRanker {
 class DataFileWriter : public TextFileWriter {
 public:
   DataFileWriter(const std::experimental::filesystem::path& path,
-                 const Table& table) noexcept
+                 const std::vector<PlayerProperties>& history) noexcept
     : TextFileWriter(path) {
-    line(table.print_as_data());
+    std::string text{header()};
+    for (const PlayerProperties& properties : history) {
+      text += "\n" + row(properties);
+    }
+    line(text);
     blank_line();
   }
+
+  /// \brief Header line of a player data file.
+  static std::string header() noexcept {
+    return "#Game# GameCategory# PlayerGame# PlayerCategoryGame# Date "
+           "AvgRating CurrentRating AvgPoints 1stPlace% 2ndPlace% 3rdPlace% "
+           "1stOr2ndPlace% 1stOr2ndOr3rdPlace% RecentAvgPoints "
+           "Recent1stPlace% RecentRatingChange WeightedAvgPoints ";
+  }
+
+  /// \brief Line of a player data file corresponding to one game.
+  static std::string row(const PlayerProperties& properties) noexcept {
+    const Percentage first{properties.place_percentage({1})};
+    const Percentage second{properties.place_percentage({2})};
+    const Percentage third{properties.place_percentage({3})};
+    return std::to_string(properties.game_number()) + " "
+           + std::to_string(properties.game_category_game_number()) + " "
+           + std::to_string(properties.player_game_number()) + " "
+           + std::to_string(properties.player_game_category_game_number()) + " "
+           + properties.date().print() + " "
+           + properties.average_elo_rating().print() + " "
+           + properties.elo_rating().print() + " "
+           + real_number_to_string(properties.average_points_per_game(), 7)
+           + " " + first.print(5) + " " + second.print(5) + " "
+           + third.print(5) + " " + (first + second).print(5) + " "
+           + (first + second + third).print(5) + " "
+           + real_number_to_string(
+               properties.recent_average_points_per_game(), 7)
+           + " " + properties.recent_first_place_percentage().print(5) + " "
+           + real_number_to_string(properties.recent_elo_rating_change(), 7)
+           + " "
+           + real_number_to_string(
+               properties.exponential_average_points_per_game(), 7)
+           + " ";
+  }
 };
 
 }  // namespace CatanRanker
@@ -61,6 +61,27 @@ public:
     return day_number_;
   }
 
+  /// \brief Last day of the month of this date.
+  constexpr Date end_of_month() const noexcept {
+    constexpr int8_t days[12]{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap_year{
+        (year_ % 4 == 0 && year_ % 100 != 0) || year_ % 400 == 0};
+    return {static_cast<int16_t>(year_), month_number_,
+            static_cast<int8_t>(month_number_ == 2 && leap_year ?
+                                    29 :
+                                    days[month_number_ - 1])};
+  }
+
+  /// \brief Last day of the month that follows the month of this date.
+  constexpr Date end_of_next_month() const noexcept {
+    if (month_number_ == 12) {
+      return Date{static_cast<int16_t>(year_ + 1), 1, 1}.end_of_month();
+    }
+    return Date{static_cast<int16_t>(year_),
+                static_cast<int8_t>(month_number_ + 1), 1}
+        .end_of_month();
+  }
+
   std::string print() const noexcept {
     const std::string month_number{
         month_number_ < 10 ? "0" + std::to_string(month_number_) :
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace CatanRanker {
+
+/// \brief Select the points of a series to keep using the
+/// Largest-Triangle-Three-Buckets algorithm. The first and last points are
+/// always kept. The remaining points are split into equally sized buckets and,
+/// in each bucket, the point that forms the largest triangle with the
+/// previously kept point and the average of the next bucket is kept. This
+/// preserves the visual shape of the series, including its peaks and troughs.
+/// Returns the indices of the kept points in increasing order. If the number
+/// of points does not exceed the threshold, every point is kept.
+std::vector<std::size_t> largest_triangle_three_buckets(
+    const std::vector<double>& x, const std::vector<double>& y,
+    const std::size_t threshold) noexcept {
+  const std::size_t size{std::min(x.size(), y.size())};
+  std::vector<std::size_t> indices;
+  if (threshold >= size || threshold < 3) {
+    for (std::size_t index = 0; index < size; ++index) {
+      indices.push_back(index);
+    }
+    return indices;
+  }
+  indices.reserve(threshold);
+  const double bucket_size{
+      static_cast<double>(size - 2) / static_cast<double>(threshold - 2)};
+  std::size_t previous{0};
+  indices.push_back(previous);
+  for (std::size_t bucket = 0; bucket < threshold - 2; ++bucket) {
+    // Average of the next bucket. The last point serves as the next bucket of
+    // the last bucket.
+    const std::size_t next_begin{
+        static_cast<std::size_t>(std::floor((bucket + 1) * bucket_size)) + 1};
+    const std::size_t next_end{std::min(
+        static_cast<std::size_t>(std::floor((bucket + 2) * bucket_size)) + 1,
+        size)};
+    double average_x{0.0};
+    double average_y{0.0};
+    for (std::size_t index = next_begin; index < next_end; ++index) {
+      average_x += x[index];
+      average_y += y[index];
+    }
+    const double next_size{static_cast<double>(next_end - next_begin)};
+    average_x /= next_size;
+    average_y /= next_size;
+    // Point of the current bucket that forms the largest triangle.
+    const std::size_t begin{
+        static_cast<std::size_t>(std::floor(bucket * bucket_size)) + 1};
+    const std::size_t end{next_begin};
+    double largest_area{-1.0};
+    std::size_t selected{begin};
+    for (std::size_t index = begin; index < end; ++index) {
+      const double area{std::abs(
+          (x[previous] - average_x) * (y[index] - y[previous])
+          - (x[previous] - x[index]) * (average_y - y[previous]))};
+      if (area > largest_area) {
+        largest_area = area;
+        selected = index;
+      }
+    }
+    indices.push_back(selected);
+    previous = selected;
+  }
+  indices.push_back(size - 1);
+  return indices;
+}
+
+}  // namespace CatanRanker
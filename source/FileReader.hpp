@@ -7,7 +7,7 @@ namespace CatanRanker {
 /// \brief General-purpose file reader base class.
 class FileReader : public File<std::ifstream> {
 protected:
-  constexpr FileReader(const std::experimental::filesystem::path& path) noexcept
+  constexpr FileReader(const std::experimental::filesystem::path& path)
     : File(path) {}
 };
 
@@ -4,10 +4,30 @@
 
 namespace CatanRanker {
 
+/// \brief Process-wide counters of the files written by the file writers. Used
+/// for profiling.
+struct FileCounters {
+  std::atomic<uint64_t> files{0};
+
+  std::atomic<uint64_t> bytes{0};
+};
+
+inline FileCounters& file_counters() noexcept {
+  static FileCounters counters;
+  return counters;
+}
+
 /// \brief General-purpose file writer base class.
 class FileWriter : public File<std::ofstream> {
 public:
   ~FileWriter() noexcept {
+    if (stream_.is_open()) {
+      const std::streamoff size{stream_.tellp()};
+      ++file_counters().files;
+      if (size > 0) {
+        file_counters().bytes += static_cast<uint64_t>(size);
+      }
+    }
     set_permissions();
   }
 
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace CatanRanker {
+
+/// \brief Recent form of a player in a game category: the average points per
+/// game, the ratio of 1st place finishes, and the Elo rating change over the
+/// player's last few games, and an exponentially weighted moving average of
+/// the points per game. The last games are kept in a ring buffer along with
+/// running sums, so adding a game takes a constant time regardless of the
+/// number of games played.
+class Form {
+public:
+  /// \brief Number of games over which the recent form is computed.
+  static constexpr std::size_t NumberOfGames{10};
+
+  /// \brief Weight of the latest game in the exponentially weighted moving
+  /// average, such that its center of mass is as recent as that of a simple
+  /// average over the last few games.
+  static constexpr double Smoothing{2.0 / (NumberOfGames + 1)};
+
+  /// \brief A game of the ring buffer: the adjusted points, whether it was a
+  /// 1st place finish, and the Elo rating of the player before the game.
+  struct Entry {
+    double points{0.0};
+
+    bool first_place{false};
+
+    double previous_elo_rating{0.0};
+  };
+
+  Form() noexcept {}
+
+  /// \brief Restore a form saved in a checkpoint. The entries are the games of
+  /// the ring buffer in the order of their slots.
+  Form(const std::size_t next, const double total_points,
+       const int64_t number_of_first_places,
+       const double exponential_average_points,
+       const std::vector<Entry>& entries) noexcept
+    : size_(std::min(entries.size(), NumberOfGames)),
+      next_(next % NumberOfGames), total_points_(total_points),
+      number_of_first_places_(number_of_first_places),
+      exponential_average_points_(exponential_average_points) {
+    std::copy(entries.cbegin(), entries.cbegin() + size_, entries_.begin());
+  }
+
+  /// \brief Add a game, which replaces the oldest game once the ring buffer is
+  /// full.
+  void add(const double points, const bool first_place,
+           const double previous_elo_rating) noexcept {
+    Entry& entry{entries_[next_]};
+    if (size_ == NumberOfGames) {
+      total_points_ -= entry.points;
+      number_of_first_places_ -= entry.first_place ? 1 : 0;
+    } else {
+      ++size_;
+    }
+    entry = {points, first_place, previous_elo_rating};
+    total_points_ += points;
+    number_of_first_places_ += first_place ? 1 : 0;
+    next_ = (next_ + 1) % NumberOfGames;
+    if (size_ == 1) {
+      exponential_average_points_ = points;
+    } else {
+      exponential_average_points_ +=
+          Smoothing * (points - exponential_average_points_);
+    }
+  }
+
+  /// \brief Number of games in the ring buffer.
+  constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  /// \brief Slot of the ring buffer to which the next game is written.
+  constexpr std::size_t next() const noexcept {
+    return next_;
+  }
+
+  constexpr double total_points() const noexcept {
+    return total_points_;
+  }
+
+  constexpr int64_t number_of_first_places() const noexcept {
+    return number_of_first_places_;
+  }
+
+  constexpr double exponential_average_points() const noexcept {
+    return exponential_average_points_;
+  }
+
+  /// \brief Games of the ring buffer in the order of their slots.
+  const Entry& entry(const std::size_t slot) const noexcept {
+    return entries_[slot];
+  }
+
+  /// \brief Average points per game over the last games, adjusted to a
+  /// 10-point game. Zero if there are no games.
+  double average_points_per_game() const noexcept {
+    return size_ > 0 ? total_points_ / static_cast<double>(size_) : 0.0;
+  }
+
+  /// \brief Ratio of 1st place finishes over the last games. Zero if there
+  /// are no games.
+  double first_place_ratio() const noexcept {
+    return size_ > 0 ? static_cast<double>(number_of_first_places_)
+                           / static_cast<double>(size_) :
+                       0.0;
+  }
+
+  /// \brief Change of the Elo rating over the last games, from before the
+  /// oldest game to a given current Elo rating. Zero if there are no games.
+  double elo_rating_change(const double elo_rating) const noexcept {
+    if (size_ == 0) {
+      return 0.0;
+    }
+    const std::size_t oldest{size_ == NumberOfGames ? next_ : 0};
+    return elo_rating - entries_[oldest].previous_elo_rating;
+  }
+
+private:
+  std::array<Entry, NumberOfGames> entries_;
+
+  std::size_t size_{0};
+
+  std::size_t next_{0};
+
+  double total_points_{0.0};
+
+  int64_t number_of_first_places_{0};
+
+  double exponential_average_points_{0.0};
+};
+
+}  // namespace CatanRanker
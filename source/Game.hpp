@@ -13,9 +13,14 @@ public:
 
   /// \brief Constructor that takes a string containing a date and a list of
   /// player names and numbers of points such as "2020-03-15 : Alice 10 , Bob 8
-  /// , Claire 7 , David 6".
-  Game(const std::string&
-           date_with_winning_points_with_player_names_and_points) {
+  /// , Claire 7 , David 6". The player names, points, and places of the game
+  /// are allocated from the given memory resource, which must outlive the game.
+  Game(const std::string& date_with_winning_points_with_player_names_and_points,
+       std::pmr::memory_resource* const resource =
+           std::pmr::get_default_resource())
+    : player_names_(resource), player_names_to_points_(resource),
+      points_to_player_names_(resource), player_names_to_places_(resource),
+      places_to_player_names_(resource) {
     const std::string initialization_error_message{
       "Cannot parse '" + date_with_winning_points_with_player_names_and_points +
       "' into a date with player names and numbers of points. Expected a format such as '2020-03-15 : Alice 10, Bob 8, Claire 7, David 5'."};
@@ -65,7 +70,7 @@ public:
   }
 
   std::optional<Points> points(const PlayerName& player_name) const noexcept {
-    const std::map<PlayerName, Points, PlayerName::sort>::const_iterator
+    const std::pmr::map<PlayerName, Points, PlayerName::sort>::const_iterator
         element{player_names_to_points_.find(player_name)};
     if (element != player_names_to_points_.cend()) {
       return element->second;
@@ -76,8 +81,8 @@ public:
   }
 
   std::optional<Place> place(const PlayerName& player_name) const noexcept {
-    const std::map<PlayerName, Place, PlayerName::sort>::const_iterator element{
-        player_names_to_places_.find(player_name)};
+    const std::pmr::map<PlayerName, Place, PlayerName::sort>::const_iterator
+        element{player_names_to_places_.find(player_name)};
     if (element != player_names_to_places_.cend()) {
       return element->second;
     } else {
@@ -94,7 +99,8 @@ public:
     return game_category(number_of_players());
   }
 
-  const std::set<PlayerName, PlayerName::sort>& player_names() const noexcept {
+  const std::pmr::set<PlayerName, PlayerName::sort>& player_names()
+      const noexcept {
     return player_names_;
   }
 
@@ -177,10 +183,10 @@ public:
   };
 
   struct const_iterator
-    : public std::set<PlayerName, PlayerName::sort>::const_iterator {
-    const_iterator(
-        const std::set<PlayerName, PlayerName::sort>::const_iterator i) noexcept
-      : std::set<PlayerName, PlayerName::sort>::const_iterator(i) {}
+    : public std::pmr::set<PlayerName, PlayerName::sort>::const_iterator {
+    const_iterator(const std::pmr::set<PlayerName, PlayerName::sort>::
+                       const_iterator i) noexcept
+      : std::pmr::set<PlayerName, PlayerName::sort>::const_iterator(i) {}
   };
 
   bool empty() const noexcept {
@@ -212,15 +218,15 @@ private:
 
   Points winning_points_{10};
 
-  std::set<PlayerName, PlayerName::sort> player_names_;
+  std::pmr::set<PlayerName, PlayerName::sort> player_names_;
 
-  std::map<PlayerName, Points, PlayerName::sort> player_names_to_points_;
+  std::pmr::map<PlayerName, Points, PlayerName::sort> player_names_to_points_;
 
-  std::multimap<Points, PlayerName, Points::sort> points_to_player_names_;
+  std::pmr::multimap<Points, PlayerName, Points::sort> points_to_player_names_;
 
-  std::map<PlayerName, Place, PlayerName::sort> player_names_to_places_;
+  std::pmr::map<PlayerName, Place, PlayerName::sort> player_names_to_places_;
 
-  std::multimap<Place, PlayerName, Place::sort> places_to_player_names_;
+  std::pmr::multimap<Place, PlayerName, Place::sort> places_to_player_names_;
 
   /// \brief Game index.
   int64_t index_{0};
@@ -291,12 +297,12 @@ private:
         error(initialization_error_message);
       }
       const Points points{points_optional_number.value()};
-      const std::pair<std::set<PlayerName>::iterator, bool>
+      const std::pair<std::pmr::set<PlayerName>::iterator, bool>
           player_names_insert_outcome{player_names_.insert(player_name)};
       if (!player_names_insert_outcome.second) {
         error(initialization_error_message);
       }
-      const std::pair<std::map<PlayerName, Points>::iterator, bool>
+      const std::pair<std::pmr::map<PlayerName, Points>::iterator, bool>
           player_names_to_points_outcome{
               player_names_to_points_.emplace(player_name, points)};
       if (!player_names_to_points_outcome.second) {
@@ -314,7 +320,7 @@ private:
     Points latest_points{MaximumPoints + 1};
     Place latest_place{0};
     PlayerName special_first_place_player;
-    const std::multimap<Place, PlayerName, Place::sort>::const_iterator
+    const std::pmr::multimap<Place, PlayerName, Place::sort>::const_iterator
         found_special_first_place{places_to_player_names_.find({1})};
     if (found_special_first_place != places_to_player_names_.cend()) {
       latest_place = found_special_first_place->first;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Context.hpp"
 #include "Game.hpp"
 #include "TextFileReader.hpp"
 
@@ -7,28 +8,97 @@ namespace CatanRanker {
 
 class Games {
 public:
-  Games(const TextFileReader& file) noexcept {
+  Games(const TextFileReader& file, Context& context) {
     message("Reading the games file...");
-    for (const std::string& line : file) {
-      if (!remove_whitespace(line).empty()) {
-        data_.emplace_back(line);
+    {
+      const Profiler::Interval interval{context.profiler, Phase::Parse};
+      for (std::size_t begin = 0; begin < file.size();
+           begin += ParseChunkSize) {
+        const std::size_t end{std::min(begin + ParseChunkSize, file.size())};
+        CATAN_RANKER_TRACE_SPAN(context.tracer, "parse",
+                                "Parse lines " + std::to_string(begin + 1)
+                                    + " to " + std::to_string(end));
+        for (TextFileReader::const_iterator line = file.cbegin() + begin;
+             line < file.cbegin() + end; ++line) {
+          if (!remove_whitespace(*line).empty()) {
+            data_.emplace_back(*line, &context.arena);
+          }
+        }
       }
     }
-    std::sort(data_.begin(), data_.end(), Game::sort());
-    std::map<GameCategory, int64_t> game_category_game_index{
-        {GameCategory::AnyNumberOfPlayers,  0},
-        {GameCategory::ThreeToFourPlayers,  0},
-        {GameCategory::FiveToSixPlayers,    0},
-        {GameCategory::SevenToEightPlayers, 0}
-    };
-    for (Game& game : data_) {
-      game.set_indices(
-          game_category_game_index[GameCategory::AnyNumberOfPlayers],
-          game_category_game_index[game.category()]);
-      ++game_category_game_index[GameCategory::AnyNumberOfPlayers];
-      ++game_category_game_index[game.category()];
+    {
+      const Profiler::Interval interval{context.profiler, Phase::Sort};
+      CATAN_RANKER_TRACE_SPAN(context.tracer, "phase", "Sort");
+      // Games of the same date keep the order of the games file, which is
+      // also the order in which added games are inserted.
+      std::stable_sort(data_.begin(), data_.end(), Game::sort());
     }
-    message(print());
+    context.profiler.add_games(data_.size());
+    initialize_indices();
+    message(data_.empty() ? "The games file is empty." :
+                            "Read " + std::to_string(data_.size()) + " games.");
+    debug([&]() { return print(); });
+  }
+
+  /// \brief Copy the games whose indices are in a range of other games, such as
+  /// the games of a season. The copies are numbered from 1, and their player
+  /// names, points, and places are allocated from the default memory resource,
+  /// so the range can be copied concurrently with other ranges.
+  Games(const Games& games, const std::size_t begin,
+        const std::size_t end) noexcept
+    : data_(games.data_.cbegin() + begin, games.data_.cbegin() + end) {
+    initialize_indices();
+  }
+
+  /// \brief Add a game after every game of the same or an earlier date and
+  /// return its index. The game should be allocated from the arena of the
+  /// context of these games. If the game is the latest one, the indices are
+  /// updated incrementally. Otherwise, the games after it are re-indexed.
+  std::size_t add(Game game) noexcept {
+    const std::vector<Game>::iterator position{
+        std::upper_bound(data_.begin(), data_.end(), game, Game::sort())};
+    const std::size_t index{
+        static_cast<std::size_t>(position - data_.begin())};
+    data_.insert(position, std::move(game));
+    if (index + 1 == data_.size()) {
+      Game& added{data_.back()};
+      std::vector<std::size_t>& category_indices{
+          game_indices_[added.category()]};
+      added.set_indices(static_cast<int64_t>(index),
+                        static_cast<int64_t>(category_indices.size()));
+      add_game_indices(index);
+    } else {
+      initialize_indices();
+    }
+    return index;
+  }
+
+  /// \brief Indices of the games in a game category, in chronological order.
+  const std::vector<std::size_t>& game_indices(
+      const GameCategory game_category) const noexcept {
+    return game_indices_.find(game_category)->second;
+  }
+
+  /// \brief Indices of the games in which a player participated in a game
+  /// category, in chronological order. Empty if the player did not participate
+  /// in any game in this game category.
+  const std::vector<std::size_t>& player_game_indices(
+      const PlayerName& player_name,
+      const GameCategory game_category) const noexcept {
+    static const std::vector<std::size_t> no_data;
+    const std::map<PlayerName,
+                   std::map<GameCategory, std::vector<std::size_t>>,
+                   PlayerName::sort>::const_iterator found{
+        player_game_indices_.find(player_name)};
+    if (found != player_game_indices_.cend()) {
+      return found->second.find(game_category)->second;
+    } else {
+      return no_data;
+    }
+  }
+
+  const Game& operator[](const std::size_t index) const noexcept {
+    return data_[index];
   }
 
   std::string print() const noexcept {
@@ -38,7 +108,7 @@ public:
     std::stringstream stream;
     stream << "There are " << data_.size() << " games:";
     for (const Game& game : data_) {
-      stream << std::endl
+      stream << '\n'
              << "- " << std::to_string(game.number()) << ": " << game.print();
     }
     return stream.str();
@@ -93,7 +163,68 @@ public:
   }
 
 private:
+  /// \brief Number of lines of the games file that are parsed in each traced
+  /// chunk.
+  static constexpr std::size_t ParseChunkSize{10000};
+
   std::vector<Game> data_;
+
+  std::map<GameCategory, std::vector<std::size_t>> game_indices_{
+      {GameCategory::AnyNumberOfPlayers,  {}},
+      {GameCategory::ThreeToFourPlayers,  {}},
+      {GameCategory::FiveToSixPlayers,    {}},
+      {GameCategory::SevenToEightPlayers, {}}
+  };
+
+  /// \brief Inverted index from each player to the indices of the games in
+  /// which the player participated, for each game category.
+  std::map<PlayerName, std::map<GameCategory, std::vector<std::size_t>>,
+           PlayerName::sort>
+      player_game_indices_;
+
+  /// \brief Set the index of each game globally and within its game category,
+  /// and build the indices of the games of each game category and player.
+  void initialize_indices() noexcept {
+    std::map<GameCategory, int64_t> game_category_game_index{
+        {GameCategory::AnyNumberOfPlayers,  0},
+        {GameCategory::ThreeToFourPlayers,  0},
+        {GameCategory::FiveToSixPlayers,    0},
+        {GameCategory::SevenToEightPlayers, 0}
+    };
+    for (Game& game : data_) {
+      game.set_indices(
+          game_category_game_index[GameCategory::AnyNumberOfPlayers],
+          game_category_game_index[game.category()]);
+      ++game_category_game_index[GameCategory::AnyNumberOfPlayers];
+      ++game_category_game_index[game.category()];
+    }
+    for (std::pair<const GameCategory, std::vector<std::size_t>>&
+             game_category_and_indices : game_indices_) {
+      game_category_and_indices.second.clear();
+    }
+    player_game_indices_.clear();
+    for (std::size_t index = 0; index < data_.size(); ++index) {
+      add_game_indices(index);
+    }
+  }
+
+  /// \brief Add the game at an index to the indices of the games of its game
+  /// category and of its participants.
+  void add_game_indices(const std::size_t index) noexcept {
+    game_indices_[GameCategory::AnyNumberOfPlayers].push_back(index);
+    game_indices_[data_[index].category()].push_back(index);
+    for (const PlayerName& player_name : data_[index]) {
+      std::map<GameCategory, std::vector<std::size_t>>& game_indices{
+          player_game_indices_[player_name]};
+      if (game_indices.empty()) {
+        for (const GameCategory game_category : GameCategories) {
+          game_indices.insert({game_category, {}});
+        }
+      }
+      game_indices[GameCategory::AnyNumberOfPlayers].push_back(index);
+      game_indices[data_[index].category()].push_back(index);
+    }
+  }
 };
 
 }  // namespace CatanRanker
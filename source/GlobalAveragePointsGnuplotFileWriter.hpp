@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GlobalDataFileWriter.hpp"
 #include "GnuplotFileWriter.hpp"
 #include "Players.hpp"
 
@@ -26,16 +27,16 @@ public:
 protected:
   virtual int8_t x_column() const noexcept = 0;
 
-  void plot(const Players& players,
-            const std::map<PlayerName, std::experimental::filesystem::path,
-                           PlayerName::sort>& data) noexcept {
+  void plot(const Players& players, const GlobalDataFile& data) noexcept {
     for (const std::pair<const PlayerName, std::experimental::filesystem::path>&
-             datum : data) {
-      line("  \"" + datum.second.string() + "\" u " + std::to_string(x_column())
-           + ":8 w lp lw 2 pt "
-           + std::to_string(players.find(datum.first).gnuplot_point_type())
-           + " ps 1 lt rgb \"#" + players.find(datum.first).color() + "\" t \""
-           + datum.first.value() + "\" , \\");
+             path : data.paths) {
+      line("  " + data_reference(path.second) + " u "
+           + std::to_string(x_column()) + ":"
+           + std::to_string(GlobalDataFile::AveragePointsColumn)
+           + " w lp lw 2 pt "
+           + std::to_string(players.find(path.first).gnuplot_point_type())
+           + " ps 1 lt rgb \"#" + players.find(path.first).color() + "\" t \""
+           + path.first.value() + "\" , \\");
     }
   }
 };
@@ -45,8 +46,7 @@ class GlobalAveragePointsVsGameNumberGnuplotFileWriter
 public:
   GlobalAveragePointsVsGameNumberGnuplotFileWriter(
       const std::experimental::filesystem::path& path, const Players& players,
-      const std::map<PlayerName, std::experimental::filesystem::path,
-                     PlayerName::sort>& data) noexcept
+      const GlobalDataFile& data) noexcept
     : GlobalAveragePointsGnuplotFileWriter(path) {
     line("set xlabel \"Game Number\"");
     line("set xtics nomirror out");
@@ -57,7 +57,7 @@ public:
 
 protected:
   int8_t x_column() const noexcept {
-    return 2;
+    return GlobalDataFile::GameCategoryGameNumberColumn;
   }
 };
 
@@ -66,8 +66,7 @@ class GlobalAveragePointsVsDateGnuplotFileWriter
 public:
   GlobalAveragePointsVsDateGnuplotFileWriter(
       const std::experimental::filesystem::path& path, const Players& players,
-      const std::map<PlayerName, std::experimental::filesystem::path,
-                     PlayerName::sort>& data) noexcept
+      const GlobalDataFile& data) noexcept
     : GlobalAveragePointsGnuplotFileWriter(path) {
     line("set timefmt \"%Y-%m-%d\"");
     line("set xlabel \"Date\"");
@@ -81,7 +80,7 @@ public:
 
 protected:
   int8_t x_column() const noexcept {
-    return 5;
+    return GlobalDataFile::DateColumn;
   }
 };
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Place.hpp"
+#include "PlayerName.hpp"
+#include "TextFileReader.hpp"
+#include "TextFileWriter.hpp"
+
+namespace CatanRanker {
+
+/// \brief Global data files of a game category, which contain the plotted
+/// columns of every player who appears in the global plots. Each player has a
+/// separate file in the directory of the game category, so that the rows of a
+/// game can be appended to the files of its participants.
+struct GlobalDataFile {
+  static constexpr int8_t GameCategoryGameNumberColumn{1};
+
+  static constexpr int8_t DateColumn{2};
+
+  static constexpr int8_t CurrentRatingColumn{3};
+
+  static constexpr int8_t AveragePointsColumn{4};
+
+  static constexpr int8_t place_percentage_column(const Place& place) noexcept {
+    return place.value() + 4;
+  }
+
+  std::experimental::filesystem::path directory;
+
+  /// \brief Global data file of each player.
+  std::map<PlayerName, std::experimental::filesystem::path, PlayerName::sort>
+      paths;
+};
+
+/// \brief Writer of the global data file of a player from the player's data
+/// file. The rows of the player data file are copied without being
+/// reformatted.
+class GlobalDataFileWriter : public TextFileWriter {
+public:
+  GlobalDataFileWriter(
+      const std::experimental::filesystem::path& path,
+      const std::experimental::filesystem::path& player_data_path) noexcept
+    : TextFileWriter(path) {
+    std::string text{Header};
+    const TextFileReader data{player_data_path};
+    for (const std::string& player_data_row : data) {
+      if (player_data_row.find_first_not_of(" \t\r\n") == std::string::npos
+          || player_data_row.front() == '#') {
+        continue;
+      }
+      text += "\n";
+      append_columns(text, player_data_row);
+    }
+    line(text);
+    blank_line();
+  }
+
+  /// \brief Row of a global data file copied from a row of a player data
+  /// file.
+  static std::string row(const std::string& player_data_row) {
+    std::string text;
+    append_columns(text, player_data_row);
+    return text;
+  }
+
+private:
+  /// \brief Columns of the player data files, numbered from 0, that are copied
+  /// to the global data file, in order.
+  static constexpr std::array<std::size_t, 7> PlayerDataColumns{
+      1, 4, 6, 7, 8, 9, 10};
+
+  static inline const std::string Header{
+      "#GameCategoryGame# Date CurrentRating AvgPoints 1stPlace% 2ndPlace% "
+      "3rdPlace% "};
+
+  /// \brief Append the copied columns of a row of a player data file. The row
+  /// is scanned in place rather than split into words because the global data
+  /// files contain the whole history of every player in the global plots.
+  static void append_columns(std::string& text, const std::string& row) {
+    std::size_t column{0};
+    std::size_t copied{0};
+    std::size_t index{0};
+    while (index < row.size() && copied < PlayerDataColumns.size()) {
+      while (index < row.size()
+             && std::isspace(static_cast<unsigned char>(row[index]))) {
+        ++index;
+      }
+      const std::size_t begin{index};
+      while (index < row.size()
+             && !std::isspace(static_cast<unsigned char>(row[index]))) {
+        ++index;
+      }
+      if (index == begin) {
+        break;
+      }
+      if (column == PlayerDataColumns[copied]) {
+        text.append(row, begin, index - begin);
+        text += ' ';
+        ++copied;
+      }
+      ++column;
+    }
+  }
+};
+
+}  // namespace CatanRanker
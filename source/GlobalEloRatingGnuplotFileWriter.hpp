@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GlobalDataFileWriter.hpp"
 #include "GnuplotFileWriter.hpp"
 #include "Players.hpp"
 
@@ -36,16 +37,16 @@ public:
 protected:
   virtual int8_t x_column() const noexcept = 0;
 
-  void plot(const Players& players,
-            const std::map<PlayerName, std::experimental::filesystem::path,
-                           PlayerName::sort>& data) noexcept {
+  void plot(const Players& players, const GlobalDataFile& data) noexcept {
     for (const std::pair<const PlayerName, std::experimental::filesystem::path>&
-             datum : data) {
-      line("  \"" + datum.second.string() + "\" u " + std::to_string(x_column())
-           + ":7 w lp lw 2 pt "
-           + std::to_string(players.find(datum.first).gnuplot_point_type())
-           + " ps 1 lt rgb \"#" + players.find(datum.first).color() + "\" t \""
-           + datum.first.value() + "\" , \\");
+             path : data.paths) {
+      line("  " + data_reference(path.second) + " u "
+           + std::to_string(x_column()) + ":"
+           + std::to_string(GlobalDataFile::CurrentRatingColumn)
+           + " w lp lw 2 pt "
+           + std::to_string(players.find(path.first).gnuplot_point_type())
+           + " ps 1 lt rgb \"#" + players.find(path.first).color() + "\" t \""
+           + path.first.value() + "\" , \\");
     }
   }
 };
@@ -55,9 +56,7 @@ class GlobalEloRatingVsGameNumberGnuplotFileWriter
 public:
   GlobalEloRatingVsGameNumberGnuplotFileWriter(
       const std::experimental::filesystem::path& path, const Players& players,
-      const std::map<PlayerName, std::experimental::filesystem::path,
-                     PlayerName::sort>& data,
-      const GameCategory game_category) noexcept
+      const GlobalDataFile& data, const GameCategory game_category) noexcept
     : GlobalEloRatingGnuplotFileWriter(
         path, players.lowest_elo_rating(game_category),
         players.highest_elo_rating(game_category)) {
@@ -70,7 +69,7 @@ public:
 
 protected:
   int8_t x_column() const noexcept {
-    return 2;
+    return GlobalDataFile::GameCategoryGameNumberColumn;
   }
 };
 
@@ -79,9 +78,7 @@ class GlobalEloRatingVsDateGnuplotFileWriter
 public:
   GlobalEloRatingVsDateGnuplotFileWriter(
       const std::experimental::filesystem::path& path, const Players& players,
-      const std::map<PlayerName, std::experimental::filesystem::path,
-                     PlayerName::sort>& data,
-      const GameCategory game_category) noexcept
+      const GlobalDataFile& data, const GameCategory game_category) noexcept
     : GlobalEloRatingGnuplotFileWriter(
         path, players.lowest_elo_rating(game_category),
         players.highest_elo_rating(game_category)) {
@@ -97,7 +94,7 @@ public:
 
 protected:
   int8_t x_column() const noexcept {
-    return 5;
+    return GlobalDataFile::DateColumn;
   }
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GlobalDataFileWriter.hpp"
 #include "GnuplotFileWriter.hpp"
 #include "Players.hpp"
 
@@ -28,21 +29,17 @@ public:
 protected:
   virtual int8_t x_column() const noexcept = 0;
 
-  constexpr int8_t y_column(const Place& place) const noexcept {
-    return place.value() + 8;
-  }
-
-  void plot(const Players& players,
-            const std::map<PlayerName, std::experimental::filesystem::path,
-                           PlayerName::sort>& data,
+  void plot(const Players& players, const GlobalDataFile& data,
             const Place& place) noexcept {
     for (const std::pair<const PlayerName, std::experimental::filesystem::path>&
-             datum : data) {
-      line("  \"" + datum.second.string() + "\" u " + std::to_string(x_column())
-           + ":" + std::to_string(y_column(place)) + " w lp lw 2 pt "
-           + std::to_string(players.find(datum.first).gnuplot_point_type())
-           + " ps 1 lt rgb \"#" + players.find(datum.first).color() + "\" t \""
-           + datum.first.value() + "\" , \\");
+             path : data.paths) {
+      line("  " + data_reference(path.second) + " u "
+           + std::to_string(x_column()) + ":"
+           + std::to_string(GlobalDataFile::place_percentage_column(place))
+           + " w lp lw 2 pt "
+           + std::to_string(players.find(path.first).gnuplot_point_type())
+           + " ps 1 lt rgb \"#" + players.find(path.first).color() + "\" t \""
+           + path.first.value() + "\" , \\");
     }
   }
 };
@@ -52,9 +49,8 @@ class GlobalPlacePercentageVsGameNumberGnuplotFileWriter
 public:
   GlobalPlacePercentageVsGameNumberGnuplotFileWriter(
       const std::experimental::filesystem::path& path, const Players& players,
-      const std::map<PlayerName, std::experimental::filesystem::path,
-                     PlayerName::sort>& data,
-      const GameCategory game_category, const Place& place) noexcept
+      const GlobalDataFile& data, const GameCategory game_category,
+      const Place& place) noexcept
     : GlobalPlacePercentageGnuplotFileWriter(path, game_category, place) {
     line("set xlabel \"Game Number\"");
     line("set xtics nomirror out");
@@ -65,7 +61,7 @@ public:
 
 protected:
   int8_t x_column() const noexcept {
-    return 2;
+    return GlobalDataFile::GameCategoryGameNumberColumn;
   }
 };
 
@@ -74,9 +70,8 @@ class GlobalPlacePercentageVsDateGnuplotFileWriter
 public:
   GlobalPlacePercentageVsDateGnuplotFileWriter(
       const std::experimental::filesystem::path& path, const Players& players,
-      const std::map<PlayerName, std::experimental::filesystem::path,
-                     PlayerName::sort>& data,
-      const GameCategory game_category, const Place& place) noexcept
+      const GlobalDataFile& data, const GameCategory game_category,
+      const Place& place) noexcept
     : GlobalPlacePercentageGnuplotFileWriter(path, game_category, place) {
     line("set timefmt \"%Y-%m-%d\"");
     line("set xlabel \"Date\"");
@@ -90,7 +85,7 @@ public:
 
 protected:
   int8_t x_column() const noexcept {
-    return 5;
+    return GlobalDataFile::DateColumn;
   }
 };
 
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "TextFileReader.hpp"
+#include "TextFileWriter.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writes a Gnuplot script that generates the plots of several Gnuplot
+/// scripts in a single Gnuplot session. The terminal is set once, each data
+/// text data file referenced by the scripts is loaded once into a datablock,
+/// and the settings are reset between plots. Binary data files cannot be
+/// stored in datablocks, so they are still read from their files.
+class GnuplotBatchFileWriter : public TextFileWriter {
+public:
+  GnuplotBatchFileWriter(
+      const std::experimental::filesystem::path& path,
+      const std::vector<std::experimental::filesystem::path>& scripts) noexcept
+    : TextFileWriter(path) {
+    std::vector<std::vector<std::string>> script_lines;
+    std::map<std::string, std::string> datablocks;
+    std::vector<std::string> data_paths;
+    for (const std::experimental::filesystem::path& script : scripts) {
+      const TextFileReader reader{script};
+      script_lines.emplace_back(reader.cbegin(), reader.cend());
+      for (const std::string& script_line : script_lines.back()) {
+        if (is_terminal(script_line) && terminal_.empty()) {
+          terminal_ = script_line;
+        }
+        const std::string data_path{data_reference(script_line)};
+        if (!data_path.empty() && datablocks.count(data_path) == 0) {
+          datablocks.emplace(
+              data_path, "$data" + std::to_string(datablocks.size() + 1));
+          data_paths.push_back(data_path);
+        }
+      }
+    }
+    line(terminal_);
+    for (const std::string& data_path : data_paths) {
+      line(datablocks[data_path] + " << EOD");
+      for (const std::string& data_line : TextFileReader{data_path}) {
+        line(data_line);
+      }
+      line("EOD");
+    }
+    for (const std::vector<std::string>& lines : script_lines) {
+      blank_line();
+      for (const std::string& script_line : lines) {
+        if (is_terminal(script_line)) {
+          continue;
+        }
+        const std::string data_path{data_reference(script_line)};
+        if (data_path.empty()) {
+          line(script_line);
+        } else {
+          line("  " + datablocks[data_path]
+               + script_line.substr(data_path.size() + 4));
+        }
+      }
+      line("reset");
+    }
+  }
+
+private:
+  std::string terminal_;
+
+  static bool is_terminal(const std::string& script_line) noexcept {
+    return script_line.rfind("set terminal ", 0) == 0;
+  }
+
+  /// \brief Path of the text data file referenced by a line of a plot command,
+  /// such as `  "path/to/data.dat" u 3:7 ...`, or an empty string if the line
+  /// does not reference a text data file.
+  static std::string data_reference(const std::string& script_line) noexcept {
+    if (script_line.rfind("  \"", 0) == 0) {
+      const std::size_t end{script_line.find('"', 3)};
+      if (end != std::string::npos) {
+        const std::string data_path{script_line.substr(3, end - 3)};
+        if (std::experimental::filesystem::path{data_path}.extension()
+            == ".dat") {
+          return data_path;
+        }
+      }
+    }
+    return {};
+  }
+};
+
+}  // namespace CatanRanker
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BinaryDataFileWriter.hpp"
 #include "Path.hpp"
 #include "TextFileWriter.hpp"
 
@@ -7,10 +8,16 @@ namespace CatanRanker {
 
 class GnuplotFileWriter : public TextFileWriter {
 public:
+  /// \brief Width of the plots in pixels.
+  static constexpr int64_t WidthPixels{1000};
+
+  /// \brief Height of the plots in pixels.
+  static constexpr int64_t HeightPixels{750};
+
   GnuplotFileWriter(const std::experimental::filesystem::path& path) noexcept
     : TextFileWriter(path) {
-    line("set terminal pngcairo size " + std::to_string(width_pixels_) + ","
-         + std::to_string(height_pixels_) + " enhanced font \"Verdana,10\"");
+    line("set terminal pngcairo size " + std::to_string(WidthPixels) + ","
+         + std::to_string(HeightPixels) + " enhanced font \"Verdana,10\"");
     line("set output \"" + png_file_path().string() + "\"");
   }
 
@@ -23,6 +30,18 @@ protected:
     return Path::gnuplot_path_to_png_path(path_);
   }
 
+  /// \brief Reference to a data file in a plot command. Binary data files are
+  /// followed by the clause that describes their format.
+  std::string data_reference(
+      const std::experimental::filesystem::path& data) const noexcept {
+    if (data.extension() == ".bin") {
+      return "\"" + data.string() + "\" "
+             + BinaryDataFileWriter::gnuplot_clause();
+    } else {
+      return "\"" + data.string() + "\"";
+    }
+  }
+
   int64_t nearest_higher_nice_number(
       const double value, const int64_t increment) const noexcept {
     return increment * static_cast<int64_t>(std::ceil(value / increment));
@@ -32,10 +51,6 @@ protected:
       const double value, const int64_t increment) const noexcept {
     return increment * static_cast<int64_t>(std::floor(value / increment));
   }
-
-  const int64_t width_pixels_{1000};
-
-  const int64_t height_pixels_{750};
 };
 
 }  // namespace CatanRanker
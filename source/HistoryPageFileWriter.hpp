@@ -0,0 +1,226 @@
+#pragma once
+
+#include "MarkdownFileWriter.hpp"
+#include "Path.hpp"
+#include "RenderCache.hpp"
+
+namespace CatanRanker {
+
+/// \brief Number of games in each page of a history. Games are only ever
+/// appended to a history, so every page except the newest one is full and its
+/// contents do not change from one run to the next.
+constexpr const std::size_t HistoryPageSize{500};
+
+/// \brief Number of pages of a history with a given number of games.
+constexpr std::size_t number_of_history_pages(
+    const std::size_t number_of_games) noexcept {
+  return (number_of_games + HistoryPageSize - 1) / HistoryPageSize;
+}
+
+/// \brief Writes one page of a history, which is a table of consecutive games
+/// listed from newest to oldest. The first line of the file is a fingerprint
+/// of its contents so that an existing page can be compared to its new
+/// contents without rendering or reading the whole page.
+class HistoryPageFileWriter : public MarkdownFileWriter {
+public:
+  /// \brief Cells of the row of a game in a page.
+  struct Row {
+    std::string game_number;
+
+    std::string date;
+
+    std::string winning_points;
+
+    std::string number_of_players;
+
+    std::string results;
+  };
+
+  /// \brief Write the page that contains the games at positions begin to end,
+  /// excluding end, of a list of game indices. The games are numbered from
+  /// their position in the list, starting at 1.
+  HistoryPageFileWriter(const std::experimental::filesystem::path& path,
+                        const std::string& title, const std::string& back_link,
+                        const Games& games, const RenderCache& cache,
+                        const std::vector<std::size_t>& game_indices,
+                        const std::size_t begin, const std::size_t end) noexcept
+    : MarkdownFileWriter(path, "") {
+    line(fingerprint_line(fingerprint(games, cache, game_indices, begin, end)));
+    Column game_number{"Game", Column::Alignment::Center};
+    Column date{"Date", Column::Alignment::Center};
+    Column winning_points{"Points", Column::Alignment::Center};
+    Column number_of_players{"Players", Column::Alignment::Center};
+    Column results{"Results", Column::Alignment::Left};
+    for (std::size_t position = end; position > begin; --position) {
+      const Game& game{games[game_indices[position - 1]]};
+      game_number.add_row(position);
+      date.add_row(game.date());
+      winning_points.add_row(game.winning_points());
+      number_of_players.add_row(game.number_of_players());
+      results.add_row(cache.game_results(game_indices[position - 1]));
+    }
+    const Table data{
+        {game_number, date, winning_points, number_of_players, results}
+    };
+    page(title, back_link, data);
+  }
+
+  /// \brief Write a page from the rows of its games, from oldest to newest.
+  /// Used to update the newest page of a history without the games that it
+  /// already contains, whose rows are read back from the existing page.
+  HistoryPageFileWriter(const std::experimental::filesystem::path& path,
+                        const std::string& title, const std::string& back_link,
+                        const std::vector<Row>& rows) noexcept
+    : MarkdownFileWriter(path, "") {
+    line(fingerprint_line(fingerprint(rows)));
+    Column game_number{"Game", Column::Alignment::Center};
+    Column date{"Date", Column::Alignment::Center};
+    Column winning_points{"Points", Column::Alignment::Center};
+    Column number_of_players{"Players", Column::Alignment::Center};
+    Column results{"Results", Column::Alignment::Left};
+    for (std::vector<Row>::const_reverse_iterator row = rows.crbegin();
+         row != rows.crend(); ++row) {
+      game_number.add_row(row->game_number);
+      date.add_row(row->date);
+      winning_points.add_row(row->winning_points);
+      number_of_players.add_row(row->number_of_players);
+      results.add_row(row->results);
+    }
+    const Table data{
+        {game_number, date, winning_points, number_of_players, results}
+    };
+    page(title, back_link, data);
+  }
+
+  /// \brief Row of a game in a page given its position in the history,
+  /// starting at 1.
+  static Row row(const std::size_t position, const Game& game) noexcept {
+    return {std::to_string(position), game.date().print(),
+            game.winning_points().print(),
+            std::to_string(game.number_of_players()), game.print_results()};
+  }
+
+  /// \brief Rows of the games of an existing page, from oldest to newest.
+  static std::vector<Row> read(
+      const std::experimental::filesystem::path& path) {
+    if (!std::experimental::filesystem::exists(path)) {
+      error("The history page does not exist: " + path.string());
+    }
+    std::vector<Row> rows;
+    std::size_t table_line{0};
+    for (const std::string& text : TextFileReader{path}) {
+      if (text.empty() || text.front() != '|') {
+        continue;
+      }
+      // The first two lines of the table are its header and its alignment.
+      if (++table_line <= 2) {
+        continue;
+      }
+      const std::vector<std::string> cells{split(text, '|')};
+      if (cells.size() != 6) {
+        error("Could not read the history page: " + path.string());
+      }
+      rows.push_back({trim(cells[1]), trim(cells[2]), trim(cells[3]),
+                      trim(cells[4]), trim(cells[5])});
+    }
+    std::reverse(rows.begin(), rows.end());
+    return rows;
+  }
+
+  /// \brief Fingerprint of the contents of a page, computed with the 64-bit
+  /// FNV-1a hash function, which is stable across compilers and runs.
+  static uint64_t fingerprint(const Games& games, const RenderCache& cache,
+                              const std::vector<std::size_t>& game_indices,
+                              const std::size_t begin,
+                              const std::size_t end) noexcept {
+    uint64_t hash{FingerprintOffsetBasis};
+    for (std::size_t position = begin; position < end; ++position) {
+      const Game& game{games[game_indices[position]]};
+      add_to_fingerprint(hash, std::to_string(position + 1));
+      add_to_fingerprint(hash, game.date().print());
+      add_to_fingerprint(hash, game.winning_points().print());
+      add_to_fingerprint(hash, cache.game_results(game_indices[position]));
+    }
+    return hash;
+  }
+
+  /// \brief Fingerprint of the contents of a page given its rows, from oldest
+  /// to newest. Equal to the fingerprint computed from the games of the page.
+  static uint64_t fingerprint(const std::vector<Row>& rows) noexcept {
+    uint64_t hash{FingerprintOffsetBasis};
+    for (const Row& row : rows) {
+      add_to_fingerprint(hash, row.game_number);
+      add_to_fingerprint(hash, row.date);
+      add_to_fingerprint(hash, row.winning_points);
+      add_to_fingerprint(hash, row.results);
+    }
+    return hash;
+  }
+
+  /// \brief Markdown list of links to the pages of the history of a game
+  /// category, from newest to oldest, relative to the directory that contains
+  /// the history directory.
+  static std::vector<std::string> links(
+      const GameCategory game_category,
+      const std::size_t number_of_games) noexcept {
+    std::vector<std::string> lines;
+    for (std::size_t page_number = number_of_history_pages(number_of_games);
+         page_number > 0; --page_number) {
+      lines.push_back(
+          "- [Games " + std::to_string((page_number - 1) * HistoryPageSize + 1)
+          + " to "
+          + std::to_string(
+              std::min(page_number * HistoryPageSize, number_of_games))
+          + "]("
+          + (Path::HistoryDirectoryName
+             / Path::history_page_file_name(game_category, page_number))
+                .string()
+          + ")");
+    }
+    return lines;
+  }
+
+  /// \brief Whether an existing page already has a given fingerprint.
+  static bool is_up_to_date(const std::experimental::filesystem::path& path,
+                            const uint64_t fingerprint) noexcept {
+    std::ifstream stream{path};
+    std::string first_line;
+    if (stream.is_open() && std::getline(stream, first_line)) {
+      return first_line == fingerprint_line(fingerprint);
+    }
+    return false;
+  }
+
+private:
+  static constexpr uint64_t FingerprintOffsetBasis{14695981039346656037ULL};
+
+  /// \brief Add a line of text to a 64-bit FNV-1a hash.
+  static void add_to_fingerprint(
+      uint64_t& hash, const std::string& text) noexcept {
+    for (const char character : text) {
+      hash ^= static_cast<unsigned char>(character);
+      hash *= 1099511628211ULL;
+    }
+    hash ^= static_cast<unsigned char>('\n');
+    hash *= 1099511628211ULL;
+  }
+
+  /// \brief Write the title, the table of games, and the links of a page.
+  void page(const std::string& title, const std::string& back_link,
+            const Table& data) noexcept {
+    blank_line();
+    this->title(title);
+    line(back_link);
+    blank_line();
+    table(data);
+    blank_line();
+    line(back_link);
+    blank_line();
+  }
+
+  static std::string fingerprint_line(const uint64_t fingerprint) noexcept {
+    return "<!-- Fingerprint: " + std::to_string(fingerprint) + " -->";
+  }
+};
+
+}  // namespace CatanRanker
@@ -52,7 +52,7 @@ protected:
                    std::experimental::filesystem::path>::const_iterator found{
         data.find(game_category)};
     if (found != data.cend()) {
-      line("  \"" + found->second.string() + "\" u "
+      line("  " + data_reference(found->second) + " u "
            + std::to_string(x_column()) + ":7 w lp lw "
            + std::to_string(line_width) + " pt 0 ps 1 lt rgb \"#" + color
            + "\" t \"" + label(game_category) + "\" , \\");
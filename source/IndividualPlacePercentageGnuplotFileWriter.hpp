@@ -27,13 +27,13 @@ protected:
   virtual int8_t x_column() const noexcept = 0;
 
   void plot(const std::experimental::filesystem::path& data) noexcept {
-    line("  \"" + data.string() + "\" u " + std::to_string(x_column())
+    line("  " + data_reference(data) + " u " + std::to_string(x_column())
          + ":9 w lp lw 4 pt 0 ps 1 lt rgb \"#" + Color::YellowWheat
          + "\" t \"1st Place\" , \\");
-    line("  \"" + data.string() + "\" u " + std::to_string(x_column())
+    line("  " + data_reference(data) + " u " + std::to_string(x_column())
          + ":10 w lp lw 3 pt 0 ps 1 lt rgb \"#" + Color::GreyOre
          + "\" t \"2nd Place\" , \\");
-    line("  \"" + data.string() + "\" u " + std::to_string(x_column())
+    line("  " + data_reference(data) + " u " + std::to_string(x_column())
          + ":11 w lp lw 2 pt 0 ps 1 lt rgb \"#" + Color::BrownDarkPort
          + "\" t \"3rd Place\" , \\");
   }
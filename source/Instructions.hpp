@@ -1,6 +1,8 @@
 #pragma once
 
-#include "Base.hpp"
+#include "SeasonSchedule.hpp"
+#include "Settings.hpp"
+#include "Tracer.hpp"
 
 namespace CatanRanker {
 
@@ -18,6 +20,56 @@ const std::string LeaderboardDirectoryKey{"--leaderboard"};
 const std::string LeaderboardDirectoryPattern{
     LeaderboardDirectoryKey + " <path>"};
 
+const std::string StreamingKey{"--streaming"};
+
+const std::string NumberOfThreadsKey{"--threads"};
+
+const std::string NumberOfThreadsPattern{NumberOfThreadsKey + " <number>"};
+
+const std::string GnuplotBatchKey{"--gnuplot-batch"};
+
+const std::string BinaryDataFilesKey{"--binary-data"};
+
+const std::string DownsamplePlotsKey{"--downsample"};
+
+const std::string ProfileKey{"--profile"};
+
+const std::string ProfileFileKey{"--profile-json"};
+
+const std::string ProfileFilePattern{ProfileFileKey + " <path>"};
+
+const std::string TraceFileKey{"--trace"};
+
+const std::string TraceFilePattern{TraceFileKey + " <path>"};
+
+const std::string LogLevelKey{"--log-level"};
+
+const std::string LogLevelPattern{LogLevelKey + " <level>"};
+
+const std::string ServeKey{"--serve"};
+
+const std::string ServePattern{ServeKey + " <path>"};
+
+const std::string HttpPortKey{"--http"};
+
+const std::string HttpPortPattern{HttpPortKey + " <port>"};
+
+const std::string AddedGameKey{"--add"};
+
+const std::string AddedGamePattern{AddedGameKey + " \"<game>\""};
+
+const std::string QueryKey{"--query"};
+
+const std::string QueryPattern{QueryKey + " \"<query>\""};
+
+const std::string SeasonsKey{"--seasons"};
+
+const std::string SeasonsPattern{SeasonsKey + " <seasons>"};
+
+const std::string BatchFileKey{"--batch"};
+
+const std::string BatchFilePattern{BatchFileKey + " <path>"};
+
 }  // namespace Arguments
 
 /// \brief Parser and organizer of the program's command-line arguments.
@@ -41,6 +93,83 @@ public:
     return leaderboard_directory_;
   }
 
+  /// \brief Whether the player histories are streamed to the player data files
+  /// instead of being kept in memory.
+  constexpr bool streaming() const noexcept {
+    return streaming_;
+  }
+
+  /// \brief Number of threads used to write the leaderboard files.
+  constexpr int64_t number_of_threads() const noexcept {
+    return number_of_threads_;
+  }
+
+  /// \brief Settings that control how the leaderboard files are written.
+  const Settings& settings() const noexcept {
+    return settings_;
+  }
+
+  /// \brief Whether the phases of the run are profiled.
+  constexpr bool profile() const noexcept {
+    return profile_;
+  }
+
+  /// \brief Path to the JSON file to which the profile is written. Empty if
+  /// the profile is not written to a file.
+  const std::experimental::filesystem::path& profile_file() const noexcept {
+    return profile_file_;
+  }
+
+  /// \brief Path to the JSON file to which the trace of the run is written.
+  /// Empty if the run is not traced.
+  const std::experimental::filesystem::path& trace_file() const noexcept {
+    return trace_file_;
+  }
+
+  /// \brief Path to the Unix domain socket on which queries are served after
+  /// the leaderboard is written. Empty if queries are not served.
+  const std::experimental::filesystem::path& socket_file() const noexcept {
+    return socket_file_;
+  }
+
+  /// \brief Port of the loopback interface on which queries are served over
+  /// HTTP after the leaderboard is written. Empty if queries are not served
+  /// over HTTP. A port of 0 is any free port.
+  const std::optional<int64_t>& http_port() const noexcept {
+    return http_port_;
+  }
+
+  /// \brief Game to be added to the games file, in the format of the games
+  /// file. Empty if no game is added.
+  const std::string& added_game() const noexcept {
+    return added_game_;
+  }
+
+  /// \brief Queries answered after the leaderboard is written, in the format of
+  /// the requests served on the socket, such as "rating Alice 2024-05-01".
+  const std::vector<std::string>& queries() const noexcept {
+    return queries_;
+  }
+
+  /// \brief Specification of the seasons whose leaderboards are written next
+  /// to the leaderboard of every game, in the format of the SeasonSchedule
+  /// class, such as "yearly". Empty if no seasons are written.
+  const std::string& seasons() const noexcept {
+    return seasons_;
+  }
+
+  /// \brief Path to the batch file listing the games file and the leaderboard
+  /// directory of each league whose leaderboard is written, in the format of
+  /// the Batch class. Empty if a single leaderboard is written.
+  const std::experimental::filesystem::path& batch_file() const noexcept {
+    return batch_file_;
+  }
+
+  /// \brief Whether queries are served after the leaderboard is written.
+  bool serve() const noexcept {
+    return !socket_file_.empty() || http_port_.has_value();
+  }
+
 private:
   std::string executable_name_;
 
@@ -50,6 +179,36 @@ private:
 
   std::experimental::filesystem::path leaderboard_directory_;
 
+  bool streaming_{false};
+
+  int64_t number_of_threads_{
+      std::max(static_cast<int64_t>(std::thread::hardware_concurrency()),
+               static_cast<int64_t>(1))};
+
+  Settings settings_;
+
+  bool profile_{false};
+
+  std::experimental::filesystem::path profile_file_;
+
+  std::experimental::filesystem::path trace_file_;
+
+  std::experimental::filesystem::path socket_file_;
+
+  std::optional<int64_t> http_port_;
+
+  std::string added_game_;
+
+  std::vector<std::string> queries_;
+
+  std::string seasons_;
+
+  std::experimental::filesystem::path batch_file_;
+
+  /// \brief Level of detail of the console messages. Empty if the given level
+  /// is not valid.
+  std::optional<LogLevel> log_level_{LogLevel::Info};
+
   void assign_arguments(int argc, char* argv[]) noexcept {
     if (argc > 1) {
       arguments_.assign(argv + 1, argv + argc);
@@ -74,8 +233,62 @@ private:
       } else if (*argument == Arguments::LeaderboardDirectoryKey
                  && argument + 1 < arguments_.cend()) {
         leaderboard_directory_ = {*(argument + 1)};
+      } else if (*argument == Arguments::StreamingKey) {
+        streaming_ = true;
+      } else if (*argument == Arguments::NumberOfThreadsKey
+                 && argument + 1 < arguments_.cend()) {
+        const std::optional<int64_t> number{
+            string_to_integer_number(*(argument + 1))};
+        number_of_threads_ = number.has_value() ? number.value() : 0;
+      } else if (*argument == Arguments::GnuplotBatchKey) {
+        settings_.gnuplot_batch = true;
+      } else if (*argument == Arguments::BinaryDataFilesKey) {
+        settings_.binary_data_files = true;
+      } else if (*argument == Arguments::DownsamplePlotsKey) {
+        settings_.downsample_plots = true;
+      } else if (*argument == Arguments::ProfileKey) {
+        profile_ = true;
+      } else if (*argument == Arguments::ProfileFileKey
+                 && argument + 1 < arguments_.cend()) {
+        profile_ = true;
+        profile_file_ = {*(argument + 1)};
+      } else if (*argument == Arguments::TraceFileKey
+                 && argument + 1 < arguments_.cend()) {
+        trace_file_ = {*(argument + 1)};
+      } else if (*argument == Arguments::ServeKey
+                 && argument + 1 < arguments_.cend()) {
+        socket_file_ = {*(argument + 1)};
+      } else if (*argument == Arguments::HttpPortKey
+                 && argument + 1 < arguments_.cend()) {
+        const std::optional<int64_t> port{
+            string_to_integer_number(*(argument + 1))};
+        http_port_ = port.has_value() ? port.value() : -1;
+      } else if (*argument == Arguments::AddedGameKey
+                 && argument + 1 < arguments_.cend()) {
+        added_game_ = *(argument + 1);
+      } else if (*argument == Arguments::QueryKey
+                 && argument + 1 < arguments_.cend()) {
+        queries_.push_back(*(argument + 1));
+      } else if (*argument == Arguments::SeasonsKey
+                 && argument + 1 < arguments_.cend()) {
+        seasons_ = *(argument + 1);
+      } else if (*argument == Arguments::BatchFileKey
+                 && argument + 1 < arguments_.cend()) {
+        batch_file_ = {*(argument + 1)};
+      } else if (*argument == Arguments::LogLevelKey
+                 && argument + 1 < arguments_.cend()) {
+        log_level_.reset();
+        for (const std::pair<const LogLevel, std::string>& level_and_label :
+             labels<LogLevel>) {
+          if (level_and_label.second == *(argument + 1)) {
+            log_level_ = level_and_label.first;
+          }
+        }
       }
     }
+    if (log_level_.has_value()) {
+      log_level() = log_level_.value();
+    }
   }
 
   void message_header_information() const noexcept {
@@ -88,17 +301,117 @@ private:
     const std::string space{"  "};
     message("Usage:");
     message(space + executable_name_ + " " + Arguments::GamesFilePattern + " "
-            + Arguments::LeaderboardDirectoryPattern);
+            + Arguments::LeaderboardDirectoryPattern + " ["
+            + Arguments::StreamingKey + "] ["
+            + Arguments::NumberOfThreadsPattern + "] ["
+            + Arguments::GnuplotBatchKey + "] ["
+            + Arguments::BinaryDataFilesKey + "] ["
+            + Arguments::DownsamplePlotsKey + "] [" + Arguments::ProfileKey
+            + "] [" + Arguments::ProfileFilePattern + "] ["
+            + Arguments::TraceFilePattern + "] [" + Arguments::LogLevelPattern
+            + "] [" + Arguments::ServePattern + "] ["
+            + Arguments::HttpPortPattern + "] [" + Arguments::AddedGamePattern
+            + "] [" + Arguments::QueryPattern + "] ["
+            + Arguments::SeasonsPattern + "]");
+    message(space + executable_name_ + " " + Arguments::BatchFilePattern
+            + " [" + Arguments::StreamingKey + "] ["
+            + Arguments::NumberOfThreadsPattern + "] ["
+            + Arguments::GnuplotBatchKey + "] ["
+            + Arguments::BinaryDataFilesKey + "] ["
+            + Arguments::DownsamplePlotsKey + "] [" + Arguments::LogLevelPattern
+            + "] [" + Arguments::SeasonsPattern + "]");
     const int64_t length{static_cast<int64_t>(
         std::max({Arguments::UsageInformation.length(),
                   Arguments::GamesFilePattern.length(),
-                  Arguments::LeaderboardDirectoryPattern.length()}))};
+                  Arguments::LeaderboardDirectoryPattern.length(),
+                  Arguments::StreamingKey.length(),
+                  Arguments::NumberOfThreadsPattern.length(),
+                  Arguments::GnuplotBatchKey.length(),
+                  Arguments::BinaryDataFilesKey.length(),
+                  Arguments::DownsamplePlotsKey.length(),
+                  Arguments::ProfileKey.length(),
+                  Arguments::ProfileFilePattern.length(),
+                  Arguments::TraceFilePattern.length(),
+                  Arguments::LogLevelPattern.length(),
+                  Arguments::ServePattern.length(),
+                  Arguments::HttpPortPattern.length(),
+                  Arguments::AddedGamePattern.length(),
+                  Arguments::QueryPattern.length(),
+                  Arguments::SeasonsPattern.length(),
+                  Arguments::BatchFilePattern.length()}))};
     message("Arguments:");
     message(space + pad_to_length(Arguments::UsageInformation, length) + space
             + "Displays this information and exits.");
     message(space + pad_to_length(Arguments::GamesFilePattern, length) + space
             + "Path to the games file to be read. Required.");
     message(space + pad_to_length(Arguments::LeaderboardDirectoryPattern, length) + space + "Path to the directory in which the leaderboard will be written. Optional. If omitted, no leaderboard is written.");
+    message(space + pad_to_length(Arguments::StreamingKey, length) + space
+            + "Writes the player data files while computing the player "
+              "histories instead of keeping the histories in memory. Reduces "
+              "memory usage for large games files. Optional.");
+    message(space + pad_to_length(Arguments::NumberOfThreadsPattern, length)
+            + space
+            + "Number of threads used to write the leaderboard files. "
+              "Optional. Defaults to the number of hardware threads.");
+    message(space + pad_to_length(Arguments::GnuplotBatchKey, length) + space
+            + "Generates the plots of each directory with a single Gnuplot "
+              "batch script instead of one Gnuplot process per plot. "
+              "Optional.");
+    message(space + pad_to_length(Arguments::BinaryDataFilesKey, length) + space
+            + "Also writes the player data files in Gnuplot's binary format "
+              "and plots from them, which avoids formatting and parsing "
+              "numbers as text. Optional.");
+    message(space + pad_to_length(Arguments::DownsamplePlotsKey, length) + space
+            + "Downsamples the plotted series to about 2 points per pixel of "
+              "plot width while preserving their shape. Optional.");
+    message(space + pad_to_length(Arguments::ProfileKey, length) + space
+            + "Prints the wall time, CPU time, and peak memory usage of each "
+              "phase of the run along with throughput counters. Optional.");
+    message(space + pad_to_length(Arguments::ProfileFilePattern, length)
+            + space
+            + "Path to a JSON file to which the profile is written. Implies "
+            + Arguments::ProfileKey + ". Optional.");
+    message(space + pad_to_length(Arguments::TraceFilePattern, length) + space
+            + "Path to a JSON file to which a trace of the run is written in "
+              "the Chrome trace event format. Optional.");
+    message(space + pad_to_length(Arguments::LogLevelPattern, length) + space
+            + "Level of detail of the console messages: quiet (warnings "
+              "only), info (a summary of the run), verbose (also the results "
+              "of every player), or debug (also every game). Optional. "
+              "Defaults to info.");
+    message(space + pad_to_length(Arguments::ServePattern, length) + space
+            + "Path to a Unix domain socket on which the ratings are served "
+              "from memory after the leaderboard is written, until a "
+              "shutdown request or an interrupt. Games can be added through "
+              "the socket. Optional.");
+    message(space + pad_to_length(Arguments::HttpPortPattern, length) + space
+            + "Port of the loopback interface on which the ratings are "
+              "served from memory as JSON over HTTP after the leaderboard is "
+              "written, until an interrupt. 0 is any free port. Optional.");
+    message(space + pad_to_length(Arguments::AddedGamePattern, length) + space
+            + "Game to be appended to the games file, such as \"2024-05-01 : "
+              "10 : Alice 10 , Bob 8 , Claire 7\". If the leaderboard was "
+              "written by a previous run and the game is its latest game, only "
+              "the leaderboard files that the game changes are updated. "
+              "Otherwise, the whole leaderboard is regenerated. Optional.");
+    message(space + pad_to_length(Arguments::QueryPattern, length) + space
+            + "Query answered as JSON after the leaderboard is written, such "
+              "as \"rating Alice 2024-05-01\" or \"ratings-at monthly 3-4\". "
+              "Takes the same queries as the socket. Can be repeated. "
+              "Optional.");
+    message(space + pad_to_length(Arguments::SeasonsPattern, length) + space
+            + "Also writes a leaderboard for each season, in which the "
+              "ratings start over, in the seasons directory of the "
+              "leaderboard. The seasons are yearly, quarterly, or start on "
+              "each of a comma-separated list of dates such as "
+              "\"2020-01-01,2020-07-01\". Optional.");
+    message(space + pad_to_length(Arguments::BatchFilePattern, length) + space
+            + "Path to a batch file in which each line contains the path to "
+              "the games file of a league followed by the path to the "
+              "directory in which its leaderboard is written. The leagues are "
+              "written concurrently by the same threads. Replaces "
+            + Arguments::GamesFileKey + " and "
+            + Arguments::LeaderboardDirectoryKey + ". Optional.");
     message("");
   }
 
@@ -118,7 +431,10 @@ private:
     if (!games_file_.empty()) {
       message("The games will be read from: " + games_file_.string());
     }
-    if (!leaderboard_directory_.empty()) {
+    if (!batch_file_.empty()) {
+      message("The leagues will be read from the batch file: "
+              + batch_file_.string());
+    } else if (!leaderboard_directory_.empty()) {
       message("The leaderboard will be written to: "
               + leaderboard_directory_.string());
     } else {
@@ -126,13 +442,145 @@ private:
           "The leaderboard directory (" + Arguments::LeaderboardDirectoryPattern
           + ") is missing. Leaderboard files will not be written.");
     }
+    if (streaming_) {
+      message("The player histories will be streamed to the data files.");
+    }
+    if (number_of_threads_ > 0) {
+      message("The leaderboard files will be written using "
+              + std::to_string(number_of_threads_)
+              + (number_of_threads_ == 1 ? " thread." : " threads."));
+    }
+    if (settings_.gnuplot_batch) {
+      message("The plots will be generated by Gnuplot batch scripts.");
+    }
+    if (settings_.binary_data_files) {
+      message("The player data files will also be written in binary format.");
+    }
+    if (settings_.downsample_plots) {
+      message("The plotted series will be downsampled.");
+    }
+    if (profile_) {
+      message("The run will be profiled.");
+    }
+    if (!profile_file_.empty()) {
+      message("The profile will be written to: " + profile_file_.string());
+    }
+    if (!trace_file_.empty()) {
+      message("The trace will be written to: " + trace_file_.string());
+    }
+    if (!socket_file_.empty()) {
+      message("The ratings will be served on: " + socket_file_.string());
+    }
+    if (http_port_.has_value()) {
+      message("The ratings will be served over HTTP on port "
+              + std::to_string(http_port_.value()) + ".");
+    }
+    if (!added_game_.empty()) {
+      message("The game will be added to the games file: " + added_game_);
+    }
+    if (!queries_.empty()) {
+      message("Queries will be answered after the leaderboard is written.");
+    }
+    if (!seasons_.empty()) {
+      message("A leaderboard will also be written for each season: "
+              + seasons_);
+    }
+    if (log_level_.has_value() && log_level_.value() > LogLevel::Info) {
+      message("Messages will be printed at the " + label(log_level_.value())
+              + " log level.");
+    }
   }
 
   void check() const {
-    if (games_file_.empty()) {
+    if (!batch_file_.empty()) {
+      check_batch();
+    } else if (games_file_.empty()) {
       message_usage_information();
       error("The games file (" + Arguments::GamesFilePattern + ") is missing.");
     }
+    if (number_of_threads_ <= 0) {
+      error("The number of threads (" + Arguments::NumberOfThreadsPattern
+            + ") must be a positive integer.");
+    }
+    if (!trace_file_.empty() && !Tracer::Available) {
+      error("The trace file (" + Arguments::TraceFilePattern
+            + ") requires the program to be built with tracing enabled.");
+    }
+    if (http_port_.has_value()
+        && (http_port_.value() < 0 || http_port_.value() > 65535)) {
+      error("The HTTP port (" + Arguments::HttpPortPattern
+            + ") must be an integer from 0 to 65535.");
+    }
+    if (serve() && streaming_) {
+      error("Serving the ratings (" + Arguments::ServePattern + " or "
+            + Arguments::HttpPortPattern
+            + ") requires the player histories to be kept in memory, which "
+              "is incompatible with "
+            + Arguments::StreamingKey + ".");
+    }
+    if (!queries_.empty() && streaming_) {
+      error("Answering queries (" + Arguments::QueryPattern
+            + ") requires the player histories to be kept in memory, which is "
+              "incompatible with "
+            + Arguments::StreamingKey + ".");
+    }
+    if (!added_game_.empty() && !queries_.empty()) {
+      error("Adding a game (" + Arguments::AddedGamePattern
+            + ") cannot be combined with answering queries ("
+            + Arguments::QueryPattern + ").");
+    }
+    if (!added_game_.empty() && serve()) {
+      error("Adding a game (" + Arguments::AddedGamePattern
+            + ") cannot be combined with serving the ratings ("
+            + Arguments::ServePattern + " or " + Arguments::HttpPortPattern
+            + "). Add games through the socket instead.");
+    }
+    if (!seasons_.empty()) {
+      // Fail early if the seasons cannot be parsed.
+      SeasonSchedule{seasons_};
+      if (leaderboard_directory_.empty() && batch_file_.empty()) {
+        error("The seasons (" + Arguments::SeasonsPattern
+              + ") require the leaderboard directory ("
+              + Arguments::LeaderboardDirectoryPattern + ").");
+      }
+      if (!added_game_.empty()) {
+        error("Adding a game (" + Arguments::AddedGamePattern
+              + ") cannot be combined with writing the seasons ("
+              + Arguments::SeasonsPattern
+              + "). Regenerate the leaderboard instead.");
+      }
+    }
+    if (!log_level_.has_value()) {
+      error("The log level (" + Arguments::LogLevelPattern
+            + ") must be quiet, info, verbose, or debug.");
+    }
+  }
+
+  /// \brief Check that the options of a batch of leagues only affect how the
+  /// leaderboards are written. The profile and the trace would mix the phases
+  /// of every league, and the other options apply to a single leaderboard.
+  void check_batch() const {
+    if (!games_file_.empty() || !leaderboard_directory_.empty()) {
+      error("The batch file (" + Arguments::BatchFilePattern
+            + ") lists the games file and the leaderboard directory of each "
+              "league, so it cannot be combined with "
+            + Arguments::GamesFilePattern + " or "
+            + Arguments::LeaderboardDirectoryPattern + ".");
+    }
+    if (!added_game_.empty() || !queries_.empty() || serve()) {
+      error("The batch file (" + Arguments::BatchFilePattern
+            + ") cannot be combined with adding a game ("
+            + Arguments::AddedGamePattern + "), answering queries ("
+            + Arguments::QueryPattern + "), or serving the ratings ("
+            + Arguments::ServePattern + " or " + Arguments::HttpPortPattern
+            + ").");
+    }
+    if (profile_ || !trace_file_.empty()) {
+      error("The batch file (" + Arguments::BatchFilePattern
+            + ") cannot be combined with profiling the run ("
+            + Arguments::ProfileKey + " or " + Arguments::ProfileFilePattern
+            + ") or tracing it (" + Arguments::TraceFilePattern + ").");
+    }
   }
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "BinaryDataFileWriter.hpp"
 #include "DataFileWriter.hpp"
+#include "GnuplotBatchFileWriter.hpp"
 #include "GlobalAveragePointsGnuplotFileWriter.hpp"
 #include "GlobalEloRatingGnuplotFileWriter.hpp"
 #include "GlobalPlacePercentageGnuplotFileWriter.hpp"
@@ -9,257 +11,873 @@
 #include "IndividualPlacePercentageGnuplotFileWriter.hpp"
 #include "LeaderboardGlobalFileWriter.hpp"
 #include "LeaderboardIndividualFileWriter.hpp"
+#include "PlotDataFileWriter.hpp"
+#include "TaskScheduler.hpp"
 
 namespace CatanRanker {
 
 /// \brief Class that writes all leaderboard files given games and players data.
+/// The leaderboard files are written by a graph of tasks executed by a task
+/// scheduler. Most tasks concern a single player and only depend on that
+/// player's previous tasks, so the players are processed in parallel.
 class Leaderboard {
 public:
   Leaderboard(const std::experimental::filesystem::path& base_directory,
-              const Games& games, const Players& players) {
+              const Games& games, const Players& players,
+              Context& context, TaskScheduler& scheduler) {
     if (!base_directory.empty()) {
-      create_directories(base_directory, players);
-      write_data_files(base_directory, players);
-      write_global_gnuplot_files(base_directory, players);
-      write_player_gnuplot_files(base_directory, players);
-      write_global_leaderboard_file(base_directory, games, players);
-      write_player_leaderboard_files(base_directory, games, players);
-      generate_global_plots(base_directory);
-      generate_player_plots(base_directory, players);
+      const Settings& settings{context.settings};
+      Profiler& profiler{context.profiler};
+      [[maybe_unused]] Tracer& tracer{context.tracer};
+      TaskGraph graph;
+      const std::size_t directories{
+          graph.add([&]() { create_directories(base_directory); })};
+      // Strings that appear in several Markdown files are rendered once.
+      RenderCache cache{games, players};
+      std::vector<std::size_t> rendered_game_results;
+      for (std::size_t begin = 0; begin < games.size();
+           begin += RenderGameResultsChunkSize) {
+        rendered_game_results.push_back(graph.add([&, begin]() {
+          const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+          CATAN_RANKER_TRACE_SPAN(tracer, "render",
+                                  "Render game results "
+                                      + std::to_string(begin + 1));
+          cache.render_game_results(
+              games, begin, begin + RenderGameResultsChunkSize);
+        }));
+      }
+      std::vector<std::size_t> rendered_summary_rows;
+      std::vector<std::size_t> data_files;
+      std::vector<std::size_t> colored_data_files;
+      std::vector<std::size_t> player_gnuplot_files;
+      std::vector<std::size_t> player_leaderboard_files;
+      std::vector<std::size_t> player_history_pages;
+      std::vector<std::size_t> player_plots;
+      for (const Player& player : players) {
+        const std::size_t data_file{graph.add(
+            [&]() {
+              const Profiler::Interval interval{profiler, Phase::DataFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "data",
+                                      "Data files of " + player.name().value());
+              create_player_directories(base_directory, player);
+              if (!players.streamed()) {
+                write_data_files(
+                    base_directory, player, settings.binary_data_files);
+              }
+              if (settings.downsample_plots) {
+                write_plot_data_files(base_directory, player, GameCategories);
+              }
+            },
+            {directories})};
+        data_files.push_back(data_file);
+        if (!player.color().empty()) {
+          colored_data_files.push_back(data_file);
+        }
+        const std::size_t player_gnuplot_file{graph.add(
+            [&]() {
+              const Profiler::Interval interval{profiler, Phase::GnuplotFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "gnuplot",
+                                      "Gnuplot files of "
+                                          + player.name().value());
+              write_player_gnuplot_files(base_directory, player, settings);
+            },
+            {data_file})};
+        player_gnuplot_files.push_back(player_gnuplot_file);
+        const std::size_t rendered_summary_row{graph.add([&]() {
+          const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+          CATAN_RANKER_TRACE_SPAN(tracer, "render",
+                                  "Render summary rows of "
+                                      + player.name().value());
+          cache.render_summary_rows(player);
+        })};
+        rendered_summary_rows.push_back(rendered_summary_row);
+        std::vector<std::size_t> player_leaderboard_file_dependencies{
+            rendered_game_results};
+        player_leaderboard_file_dependencies.push_back(player_gnuplot_file);
+        player_leaderboard_file_dependencies.push_back(rendered_summary_row);
+        player_leaderboard_files.push_back(graph.add(
+            [&]() {
+              const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "markdown",
+                                      "Leaderboard of "
+                                          + player.name().value());
+              LeaderboardIndividualFileWriter{base_directory, player, cache};
+            },
+            player_leaderboard_file_dependencies));
+        std::vector<std::size_t> player_history_pages_dependencies{
+            rendered_game_results};
+        player_history_pages_dependencies.push_back(data_file);
+        player_history_pages.push_back(graph.add(
+            [&]() {
+              const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "markdown",
+                                      "History pages of "
+                                          + player.name().value());
+              write_player_history_pages(base_directory, games, player, cache);
+            },
+            player_history_pages_dependencies));
+        player_plots.push_back(graph.add(
+            [&]() {
+              const Profiler::Interval interval{profiler, Phase::PlayerPlots};
+              CATAN_RANKER_TRACE_SPAN(tracer, "plots",
+                                      "Plots of " + player.name().value());
+              generate_plots(player_gnuplot_paths(base_directory, player),
+                             settings.gnuplot_batch,
+                             base_directory / player.name().directory_name()
+                                 / Path::PlayerPlotsDirectoryName,
+                             context);
+            },
+            {player_gnuplot_file}));
+      }
+      std::vector<std::size_t> global_gnuplot_files;
+      std::vector<std::size_t> global_plots;
+      std::vector<std::size_t> global_history_pages;
+      std::vector<std::size_t> global_data_files;
+      for (const GameCategory game_category : GameCategories) {
+        std::vector<std::size_t> global_history_pages_dependencies{
+            rendered_game_results};
+        global_history_pages_dependencies.push_back(directories);
+        global_history_pages.push_back(graph.add(
+            [&, game_category]() {
+              const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "markdown",
+                                      "Global history pages of "
+                                          + label(game_category));
+              write_global_history_pages(
+                  base_directory, games, cache, game_category);
+            },
+            global_history_pages_dependencies));
+        const std::size_t global_gnuplot_file{graph.add(
+            [&, game_category]() {
+              const Profiler::Interval interval{profiler, Phase::GnuplotFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "gnuplot",
+                                      "Global Gnuplot files of "
+                                          + label(game_category));
+              write_global_gnuplot_files(
+                  base_directory, players, settings, game_category);
+            },
+            {directories})};
+        global_gnuplot_files.push_back(global_gnuplot_file);
+        std::vector<std::size_t> global_data_file_dependencies{
+            colored_data_files};
+        global_data_file_dependencies.push_back(directories);
+        const std::size_t global_data_file{graph.add(
+            [&, game_category]() {
+              const Profiler::Interval interval{profiler, Phase::DataFiles};
+              CATAN_RANKER_TRACE_SPAN(tracer, "data",
+                                      "Global data files of "
+                                          + label(game_category));
+              write_global_data_files(
+                  base_directory, players, settings, game_category);
+            },
+            global_data_file_dependencies)};
+        global_data_files.push_back(global_data_file);
+        if (!settings.gnuplot_batch) {
+          global_plots.push_back(graph.add(
+              [&, game_category]() {
+                const Profiler::Interval interval{profiler, Phase::GlobalPlots};
+                CATAN_RANKER_TRACE_SPAN(tracer, "plots",
+                                        "Global plots of "
+                                            + label(game_category));
+                generate_plots(
+                    global_gnuplot_paths(base_directory, game_category), false,
+                    base_directory / Path::MainPlotsDirectoryName, context);
+              },
+              {global_data_file, global_gnuplot_file}));
+        }
+      }
+      if (settings.gnuplot_batch) {
+        // A single batch script generates the global plots of every game
+        // category.
+        std::vector<std::size_t> global_plot_dependencies{global_data_files};
+        global_plot_dependencies.insert(global_plot_dependencies.end(),
+                                        global_gnuplot_files.cbegin(),
+                                        global_gnuplot_files.cend());
+        global_plots.push_back(graph.add(
+            [&]() {
+              const Profiler::Interval interval{profiler, Phase::GlobalPlots};
+              CATAN_RANKER_TRACE_SPAN(tracer, "plots", "Global plots");
+              std::vector<std::experimental::filesystem::path> paths;
+              for (const GameCategory game_category : GameCategories) {
+                const std::vector<std::experimental::filesystem::path>
+                    category_paths{
+                        global_gnuplot_paths(base_directory, game_category)};
+                paths.insert(paths.end(), category_paths.cbegin(),
+                             category_paths.cend());
+              }
+              generate_plots(paths, true,
+                             base_directory / Path::MainPlotsDirectoryName,
+                             context);
+            },
+            global_plot_dependencies));
+      }
+      std::vector<std::size_t> global_leaderboard_file_dependencies{
+          global_gnuplot_files};
+      global_leaderboard_file_dependencies.insert(
+          global_leaderboard_file_dependencies.end(),
+          rendered_game_results.cbegin(), rendered_game_results.cend());
+      global_leaderboard_file_dependencies.insert(
+          global_leaderboard_file_dependencies.end(),
+          rendered_summary_rows.cbegin(), rendered_summary_rows.cend());
+      const std::size_t global_leaderboard_file{graph.add(
+          [&]() {
+            const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+            CATAN_RANKER_TRACE_SPAN(tracer, "markdown", "Global leaderboard");
+            LeaderboardGlobalFileWriter{base_directory, players, cache};
+          },
+          global_leaderboard_file_dependencies)};
+      if (!players.streamed()) {
+        graph.add([]() { message("Wrote the data files."); }, data_files);
+      }
+      graph.add([]() { message("Wrote the global data files."); },
+                global_data_files);
+      graph.add([]() { message("Wrote the global Gnuplot files."); },
+                global_gnuplot_files);
+      graph.add(
+          []() { message("Wrote the individual player Gnuplot files."); },
+          player_gnuplot_files);
+      graph.add(
+          []() { message("Wrote the global leaderboard Markdown file."); },
+          {global_leaderboard_file});
+      graph.add(
+          []() {
+            message("Wrote the individual player leaderboard Markdown files.");
+          },
+          player_leaderboard_files);
+      graph.add(
+          []() { message("Wrote the global history Markdown files."); },
+          global_history_pages);
+      graph.add(
+          []() {
+            message("Wrote the individual player history Markdown files.");
+          },
+          player_history_pages);
+      graph.add([]() { message("Generated the global plots."); }, global_plots);
+      graph.add([]() { message("Generated the individual player plots."); },
+                player_plots);
+      CATAN_RANKER_TRACE_SPAN(tracer, "phase", "Leaderboard");
+      graph.run(scheduler);
+    }
+  }
+
+  /// \brief Update an existing leaderboard for a game that was added after
+  /// every other game, given the players after the game. Only the files that
+  /// the game changes are written: the data files, plots, newest history
+  /// pages, and leaderboard file of each participant, the global data files of
+  /// the participants, the global plots and newest history pages of the game's
+  /// categories, and the global leaderboard file. If the colors of the players
+  /// changed, the global data files and plots of every game category are
+  /// written. The files are written in sequence since there are few.
+  Leaderboard(const std::experimental::filesystem::path& base_directory,
+              const Game& game, const Players& players, const bool recolored,
+              Context& context) {
+    const Settings& settings{context.settings};
+    Profiler& profiler{context.profiler};
+    [[maybe_unused]] Tracer& tracer{context.tracer};
+    CATAN_RANKER_TRACE_SPAN(tracer, "phase", "Leaderboard Update");
+    const std::set<GameCategory> game_categories{
+        game.category(), GameCategory::AnyNumberOfPlayers};
+    const std::set<GameCategory>& global_game_categories{
+        recolored ? GameCategories : game_categories};
+    std::vector<const Player*> participants;
+    for (const PlayerName& player_name : game) {
+      participants.push_back(&players.find(player_name));
+    }
+    {
+      const Profiler::Interval interval{profiler, Phase::DataFiles};
+      for (const Player* player : participants) {
+        create_player_directories(base_directory, *player);
+        for (const GameCategory game_category : game_categories) {
+          append_data_files(base_directory, *player, game_category,
+                            settings.binary_data_files);
+        }
+        if (settings.downsample_plots) {
+          write_plot_data_files(base_directory, *player, game_categories);
+        }
+      }
+      for (const GameCategory game_category : global_game_categories) {
+        if (recolored) {
+          write_global_data_files(
+              base_directory, players, settings, game_category);
+        } else {
+          append_global_data_files(
+              base_directory, participants, settings, game_category);
+        }
+      }
+    }
+    {
+      const Profiler::Interval interval{profiler, Phase::GnuplotFiles};
+      for (const Player* player : participants) {
+        write_player_gnuplot_files(base_directory, *player, settings);
+      }
+      for (const GameCategory game_category : global_game_categories) {
+        write_global_gnuplot_files(
+            base_directory, players, settings, game_category);
+      }
+    }
+    {
+      const Profiler::Interval interval{profiler, Phase::MarkdownFiles};
+      RenderCache cache{players};
+      for (const Player& player : players) {
+        cache.render_summary_rows(player);
+      }
+      for (const Player* player : participants) {
+        for (const GameCategory game_category : game_categories) {
+          add_to_history(
+              player_history(base_directory, *player, game_category),
+              game_category,
+              static_cast<std::size_t>(player->number_of_games(game_category)),
+              game);
+        }
+        LeaderboardIndividualFileWriter{base_directory, *player, cache};
+      }
+      for (const GameCategory game_category : game_categories) {
+        add_to_history(
+            global_history(base_directory, game_category), game_category,
+            static_cast<std::size_t>(
+                game_category == GameCategory::AnyNumberOfPlayers ?
+                    game.number() :
+                    game.category_number()),
+            game);
+      }
+      LeaderboardGlobalFileWriter{base_directory, players, cache};
+    }
+    message("Updated the leaderboard files of the "
+            + std::to_string(participants.size()) + " participants.");
+    {
+      const Profiler::Interval interval{profiler, Phase::PlayerPlots};
+      for (const Player* player : participants) {
+        generate_plots(player_gnuplot_paths(base_directory, *player),
+                       settings.gnuplot_batch,
+                       base_directory / player->name().directory_name()
+                           / Path::PlayerPlotsDirectoryName,
+                       context);
+      }
+    }
+    {
+      const Profiler::Interval interval{profiler, Phase::GlobalPlots};
+      std::vector<std::experimental::filesystem::path> paths;
+      for (const GameCategory game_category : global_game_categories) {
+        const std::vector<std::experimental::filesystem::path> category_paths{
+            global_gnuplot_paths(base_directory, game_category)};
+        paths.insert(
+            paths.end(), category_paths.cbegin(), category_paths.cend());
+      }
+      generate_plots(paths, settings.gnuplot_batch,
+                     base_directory / Path::MainPlotsDirectoryName, context);
     }
   }
 
 private:
+  /// \brief Number of games whose results are rendered by a single task.
+  static constexpr std::size_t RenderGameResultsChunkSize{1024};
+
+  /// \brief Maximum number of rows of a downsampled data file: about 2 points
+  /// per horizontal pixel of a plot.
+  static constexpr std::size_t PlotDataMaximumNumberOfRows{
+      2 * GnuplotFileWriter::WidthPixels};
+
   void create_directories(
-      const std::experimental::filesystem::path& base_directory,
-      const Players& players) {
+      const std::experimental::filesystem::path& base_directory) const {
     create(base_directory);
     create(base_directory / Path::PlayersDirectoryName);
     create(base_directory / Path::MainPlotsDirectoryName);
-    for (const Player& player : players) {
-      create(base_directory / player.name().directory_name());
-      create(base_directory / player.name().directory_name()
-             / Path::PlayerDataDirectoryName);
-      create(base_directory / player.name().directory_name()
-             / Path::PlayerPlotsDirectoryName);
-    }
+    create(base_directory / Path::MainDataDirectoryName);
+    create(base_directory / Path::HistoryDirectoryName);
+  }
+
+  void create_player_directories(
+      const std::experimental::filesystem::path& base_directory,
+      const Player& player) const {
+    create(base_directory / player.name().directory_name());
+    create(base_directory / player.name().directory_name()
+           / Path::PlayerDataDirectoryName);
+    create(base_directory / player.name().directory_name()
+           / Path::PlayerPlotsDirectoryName);
+    create(base_directory / player.name().directory_name()
+           / Path::HistoryDirectoryName);
   }
 
   void write_data_files(
       const std::experimental::filesystem::path& base_directory,
-      const Players& players) noexcept {
-    for (const Player& player : players) {
-      for (const GameCategory game_category : GameCategories) {
-        if (!player[game_category].empty()) {
-          DataFileWriter{base_directory / player.name().directory_name()
-                             / Path::PlayerDataDirectoryName
-                             / Path::player_data_file_name(game_category),
-                         player_table(player, game_category)};
+      const Player& player, const bool binary) const noexcept {
+    for (const GameCategory game_category : GameCategories) {
+      if (player.number_of_games(game_category) > 0) {
+        DataFileWriter{base_directory / player.name().directory_name()
+                           / Path::PlayerDataDirectoryName
+                           / Path::player_data_file_name(game_category),
+                       player[game_category]};
+        if (binary) {
+          BinaryDataFileWriter{
+              base_directory / player.name().directory_name()
+                  / Path::PlayerDataDirectoryName
+                  / Path::player_binary_data_file_name(game_category),
+              player[game_category]};
         }
       }
     }
-    message("Wrote the data files.");
   }
 
-  void write_global_gnuplot_files(
+  /// \brief Write a downsampled copy of the data files of a player in some game
+  /// categories. The data files are read back from disk so that this also works
+  /// when the player histories are streamed instead of kept in memory.
+  void write_plot_data_files(
       const std::experimental::filesystem::path& base_directory,
-      const Players& players) noexcept {
+      const Player& player,
+      const std::set<GameCategory>& game_categories) const noexcept {
+    for (const GameCategory game_category : game_categories) {
+      if (player.number_of_games(game_category) > 0) {
+        const std::experimental::filesystem::path directory{
+            base_directory / player.name().directory_name()
+            / Path::PlayerDataDirectoryName};
+        PlotDataFileWriter{
+            directory / Path::player_plot_data_file_name(game_category),
+            DataFileReader{
+                directory / Path::player_data_file_name(game_category)},
+            PlotDataMaximumNumberOfRows};
+      }
+    }
+  }
+
+  /// \brief Path to the data file of a player in a game category that is read
+  /// by the Gnuplot files. Downsampled data files are small, so they are only
+  /// written as text.
+  std::experimental::filesystem::path plotted_data_path(
+      const std::experimental::filesystem::path& base_directory,
+      const Player& player, const GameCategory game_category,
+      const Settings& settings) const noexcept {
+    const std::experimental::filesystem::path directory{
+        base_directory / player.name().directory_name()
+        / Path::PlayerDataDirectoryName};
+    if (settings.downsample_plots) {
+      return directory / Path::player_plot_data_file_name(game_category);
+    } else if (settings.binary_data_files) {
+      return directory / Path::player_binary_data_file_name(game_category);
+    } else {
+      return directory / Path::player_data_file_name(game_category);
+    }
+  }
+
+  /// \brief Location and headings of the pages of a history.
+  struct History {
+    std::experimental::filesystem::path directory;
+
+    std::string title;
+
+    std::string back_link;
+  };
+
+  History global_history(
+      const std::experimental::filesystem::path& base_directory,
+      const GameCategory game_category) const noexcept {
+    const std::string section{label(game_category) + " History"};
+    return {base_directory / Path::HistoryDirectoryName, section,
+            "[(Back to Leaderboard)](../#"
+                + lowercase(replace_character(section, ' ', '-')) + ")"};
+  }
+
+  History player_history(
+      const std::experimental::filesystem::path& base_directory,
+      const Player& player, const GameCategory game_category) const noexcept {
+    const std::string section{label(game_category) + " History"};
+    return {base_directory / player.name().directory_name()
+                / Path::HistoryDirectoryName,
+            player.name().value() + " " + section,
+            "[(Back to " + player.name().value() + ")](../#"
+                + lowercase(replace_character(section, ' ', '-')) + ")"};
+  }
+
+  void write_global_history_pages(
+      const std::experimental::filesystem::path& base_directory,
+      const Games& games, const RenderCache& cache,
+      const GameCategory game_category) const {
+    write_history_pages(global_history(base_directory, game_category), games,
+                        cache, game_category,
+                        games.game_indices(game_category));
+  }
+
+  void write_player_history_pages(
+      const std::experimental::filesystem::path& base_directory,
+      const Games& games, const Player& player,
+      const RenderCache& cache) const {
     for (const GameCategory game_category : GameCategories) {
-      std::map<PlayerName, std::experimental::filesystem::path,
-               PlayerName::sort>
-          data_paths;
-      for (const Player& player : players) {
-        if (!player[game_category].empty() && !player.color().empty()) {
-          data_paths.insert({player.name(),
-                             base_directory / player.name().directory_name()
-                                 / Path::PlayerDataDirectoryName
-                                 / Path::player_data_file_name(game_category)});
-        }
+      write_history_pages(
+          player_history(base_directory, player, game_category), games, cache,
+          game_category,
+          games.player_game_indices(player.name(), game_category));
+    }
+  }
+
+  /// \brief Write the pages of a history. A full page that already exists and
+  /// whose fingerprint has not changed is not rewritten, so when games are
+  /// appended only the newest pages are written. Pages beyond the end of the
+  /// history, which only exist if games were removed, are deleted.
+  void write_history_pages(const History& history, const Games& games,
+                           const RenderCache& cache,
+                           const GameCategory game_category,
+                           const std::vector<std::size_t>& game_indices) const {
+    const std::size_t number_of_pages{
+        number_of_history_pages(game_indices.size())};
+    for (std::size_t page_number = 1; page_number <= number_of_pages;
+         ++page_number) {
+      const std::size_t begin{(page_number - 1) * HistoryPageSize};
+      const std::size_t end{
+          std::min(page_number * HistoryPageSize, game_indices.size())};
+      const std::experimental::filesystem::path path{
+          history.directory
+          / Path::history_page_file_name(game_category, page_number)};
+      if (page_number < number_of_pages
+          && HistoryPageFileWriter::is_up_to_date(
+              path, HistoryPageFileWriter::fingerprint(
+                        games, cache, game_indices, begin, end))) {
+        continue;
       }
-      if (!data_paths.empty()) {
-        GlobalEloRatingVsGameNumberGnuplotFileWriter{
-            base_directory / Path::MainPlotsDirectoryName
-                / Path::global_elo_rating_vs_game_number_file_name(
-                    game_category),
-            players, data_paths, game_category};
-        GlobalAveragePointsVsGameNumberGnuplotFileWriter{
-            base_directory / Path::MainPlotsDirectoryName
-                / Path::global_average_points_vs_game_number_file_name(
-                    game_category),
-            players, data_paths};
-        GlobalPlacePercentageVsGameNumberGnuplotFileWriter{
-            base_directory / Path::MainPlotsDirectoryName
-                / Path::global_place_percentage_vs_game_number_file_name(
-                    game_category, {1}),
-            players,
-            data_paths,
-            game_category,
-            {1}};
+      HistoryPageFileWriter{path,
+                            page_title(history, begin, end),
+                            history.back_link,
+                            games,
+                            cache,
+                            game_indices,
+                            begin,
+                            end};
+    }
+    for (std::size_t page_number = number_of_pages + 1;; ++page_number) {
+      const std::experimental::filesystem::path path{
+          history.directory
+          / Path::history_page_file_name(game_category, page_number)};
+      if (!std::experimental::filesystem::exists(path)) {
+        break;
       }
+      std::experimental::filesystem::remove(path);
     }
-    message("Wrote the global Gnuplot files.");
   }
 
-  void write_player_gnuplot_files(
+  /// \brief Title of the page of a history that contains the games at
+  /// positions begin to end, excluding end.
+  static std::string page_title(const History& history, const std::size_t begin,
+                                const std::size_t end) noexcept {
+    return history.title + ", Games " + std::to_string(begin + 1) + " to "
+           + std::to_string(end);
+  }
+
+  /// \brief Add a game to the end of a history that contains a given number of
+  /// games including this one. The newest page is read back and rewritten with
+  /// the game, or a new page is started if the newest page is full, so the
+  /// other games of the history are not needed.
+  void add_to_history(
+      const History& history, const GameCategory game_category,
+      const std::size_t number_of_games, const Game& game) const {
+    const std::size_t page_number{number_of_history_pages(number_of_games)};
+    const std::size_t begin{(page_number - 1) * HistoryPageSize};
+    const std::experimental::filesystem::path path{
+        history.directory
+        / Path::history_page_file_name(game_category, page_number)};
+    std::vector<HistoryPageFileWriter::Row> rows;
+    if (begin + 1 < number_of_games) {
+      rows = HistoryPageFileWriter::read(path);
+      if (rows.size() != number_of_games - begin - 1
+          || rows.front().game_number != std::to_string(begin + 1)) {
+        error("The history page is out of date: " + path.string());
+      }
+    }
+    rows.push_back(HistoryPageFileWriter::row(number_of_games, game));
+    HistoryPageFileWriter{
+        path, page_title(history, begin, number_of_games), history.back_link,
+        rows};
+  }
+
+  /// \brief Append the latest properties of a player in a game category to the
+  /// player's data files, or write the data files if the player had no games in
+  /// that game category. A text data file ends with a blank line, which is
+  /// replaced by the new row.
+  void append_data_files(
       const std::experimental::filesystem::path& base_directory,
-      const Players& players) noexcept {
-    for (const Player& player : players) {
-      std::map<GameCategory, std::experimental::filesystem::path> data_paths;
-      for (const GameCategory game_category : GameCategories) {
-        // Only generate a plot if this player has at least 2 games in this game
-        // category.
-        if (player[game_category].size() >= 2) {
-          data_paths.insert({game_category,
-                             base_directory / player.name().directory_name()
-                                 / Path::PlayerDataDirectoryName
-                                 / Path::player_data_file_name(game_category)});
-        }
+      const Player& player, const GameCategory game_category,
+      const bool binary) const {
+    const PlayerProperties& latest{
+        player.latest_properties(game_category).value()};
+    const std::experimental::filesystem::path directory{
+        base_directory / player.name().directory_name()
+        / Path::PlayerDataDirectoryName};
+    const std::experimental::filesystem::path path{
+        directory / Path::player_data_file_name(game_category)};
+    const std::experimental::filesystem::path binary_path{
+        directory / Path::player_binary_data_file_name(game_category)};
+    if (player.number_of_games(game_category) == 1) {
+      DataFileWriter{path, {latest}};
+      if (binary) {
+        BinaryDataFileWriter{binary_path, {latest}};
       }
-      if (!data_paths.empty()) {
-        IndividualEloRatingVsGameNumberGnuplotFileWriter{
-            base_directory / player.name().directory_name()
-                / Path::PlayerPlotsDirectoryName
-                / Path::PlayerEloRatingVsGameNumberFileName,
-            data_paths, player.lowest_elo_rating(),
-            player.highest_elo_rating()};
-        IndividualAveragePointsVsGameNumberGnuplotFileWriter{
-            base_directory / player.name().directory_name()
-                / Path::PlayerPlotsDirectoryName
-                / Path::PlayerAveragePointsVsGameNumberFileName,
-            data_paths};
+      return;
+    }
+    append_row(path, DataFileWriter::row(latest));
+    if (binary) {
+      std::ofstream binary_stream{
+          binary_path.string(), std::ios::app | std::ios::binary};
+      if (!binary_stream.is_open()) {
+        error("Could not open the file: " + binary_path.string());
       }
-      if (player[GameCategory::AnyNumberOfPlayers].size() >= 2) {
-        IndividualPlacePercentageVsGameNumberGnuplotFileWriter{
-            base_directory / player.name().directory_name()
-                / Path::PlayerPlotsDirectoryName
-                / Path::individual_place_percentage_vs_game_number_file_name(
-                    GameCategory::AnyNumberOfPlayers),
-            base_directory / player.name().directory_name()
-                / Path::PlayerDataDirectoryName
-                / Path::player_data_file_name(GameCategory::AnyNumberOfPlayers),
-            GameCategory::AnyNumberOfPlayers};
+      binary_stream << BinaryDataFileWriter::record(latest);
+      file_counters().bytes += BinaryDataFileWriter::RecordSize;
+    }
+  }
+
+  /// \brief Append a row to a data file, which ends with a blank line that is
+  /// replaced by the row.
+  static void append_row(const std::experimental::filesystem::path& path,
+                         const std::string& row) {
+    std::fstream stream{
+        path.string(), std::ios::in | std::ios::out | std::ios::binary};
+    char ending[2]{};
+    if (stream.is_open()) {
+      stream.seekg(-2, std::ios::end);
+      stream.read(ending, 2);
+    }
+    if (!stream || ending[0] != '\n' || ending[1] != '\n') {
+      error("The data file is out of date: " + path.string());
+    }
+    const std::string text{row + "\n\n"};
+    stream.seekp(-1, std::ios::end);
+    stream << text;
+    file_counters().bytes += text.size() - 1;
+  }
+
+  /// \brief Global data files of a game category. They contain the players who
+  /// appear in the global plots, which are the players with a color who have
+  /// games in that game category.
+  GlobalDataFile global_data_file(
+      const std::experimental::filesystem::path& base_directory,
+      const Players& players, const GameCategory game_category) const noexcept {
+    GlobalDataFile data;
+    data.directory = base_directory / Path::MainDataDirectoryName
+                     / Path::global_data_directory_name(game_category);
+    for (const Player& player : players) {
+      if (player.number_of_games(game_category) > 0
+          && !player.color().empty()) {
+        data.paths.insert(
+            {player.name(), data.directory
+                                / Path::global_data_file_name(
+                                    player.name().value())});
       }
     }
-    message("Wrote the individual player Gnuplot files.");
+    return data;
   }
 
-  void write_global_leaderboard_file(
+  /// \brief Path to the data file of a player in a game category from which
+  /// the player's global data file is copied: the downsampled data file if
+  /// requested.
+  std::experimental::filesystem::path global_data_source_path(
       const std::experimental::filesystem::path& base_directory,
-      const Games& games, const Players& players) noexcept {
-    LeaderboardGlobalFileWriter{base_directory, games, players};
-    message("Wrote the global leaderboard Markdown file.");
+      const PlayerName& player_name, const Settings& settings,
+      const GameCategory game_category) const noexcept {
+    return base_directory / player_name.directory_name()
+           / Path::PlayerDataDirectoryName
+           / (settings.downsample_plots ?
+                  Path::player_plot_data_file_name(game_category) :
+                  Path::player_data_file_name(game_category));
   }
 
-  void write_player_leaderboard_files(
+  /// \brief Write the global data files of a game category from the data files
+  /// of its players. The global data files of players who no longer appear in
+  /// the global plots are removed.
+  void write_global_data_files(
       const std::experimental::filesystem::path& base_directory,
-      const Games& games, const Players& players) noexcept {
-    for (const Player& player : players) {
-      LeaderboardIndividualFileWriter{base_directory, games, player};
+      const Players& players, const Settings& settings,
+      const GameCategory game_category) const {
+    const GlobalDataFile data{
+        global_data_file(base_directory, players, game_category)};
+    std::error_code error_code;
+    std::experimental::filesystem::remove_all(data.directory, error_code);
+    if (!data.paths.empty()) {
+      create(data.directory);
+      for (const std::pair<const PlayerName,
+                           std::experimental::filesystem::path>& path :
+           data.paths) {
+        GlobalDataFileWriter{
+            path.second, global_data_source_path(base_directory, path.first,
+                                                 settings, game_category)};
+      }
     }
-    message("Wrote the individual player leaderboard Markdown files.");
   }
 
-  void generate_global_plots(
-      const std::experimental::filesystem::path& base_directory) const {
-    message("Generating the global plots...");
-    for (const GameCategory game_category : GameCategories) {
-      generate_plot(
+  /// \brief Append the latest row of each participant of a game to the
+  /// participant's global data file in a game category, which does not depend
+  /// on the number of games. A global data file that does not exist yet is
+  /// written instead, and so is a downsampled one since the participant's
+  /// downsampled data file changes as a whole.
+  void append_global_data_files(
+      const std::experimental::filesystem::path& base_directory,
+      const std::vector<const Player*>& participants, const Settings& settings,
+      const GameCategory game_category) const {
+    for (const Player* player : participants) {
+      if (player->number_of_games(game_category) == 0
+          || player->color().empty()) {
+        continue;
+      }
+      const std::experimental::filesystem::path directory{
+          base_directory / Path::MainDataDirectoryName
+          / Path::global_data_directory_name(game_category)};
+      const std::experimental::filesystem::path path{
+          directory / Path::global_data_file_name(player->name().value())};
+      if (settings.downsample_plots
+          || !std::experimental::filesystem::exists(path)) {
+        create(directory);
+        GlobalDataFileWriter{
+            path, global_data_source_path(base_directory, player->name(),
+                                          settings, game_category)};
+      } else {
+        const PlayerProperties& latest{
+            player->latest_properties(game_category).value()};
+        append_row(
+            path, GlobalDataFileWriter::row(DataFileWriter::row(latest)));
+      }
+    }
+  }
+
+  void write_global_gnuplot_files(
+      const std::experimental::filesystem::path& base_directory,
+      const Players& players, const Settings& settings,
+      const GameCategory game_category) const noexcept {
+    const GlobalDataFile data{
+        global_data_file(base_directory, players, game_category)};
+    if (!data.paths.empty()) {
+      GlobalEloRatingVsGameNumberGnuplotFileWriter{
+          base_directory / Path::MainPlotsDirectoryName
+              / Path::global_elo_rating_vs_game_number_file_name(game_category),
+          players, data, game_category};
+      GlobalAveragePointsVsGameNumberGnuplotFileWriter{
           base_directory / Path::MainPlotsDirectoryName
-          / Path::global_elo_rating_vs_game_number_file_name(game_category));
-      generate_plot(base_directory / Path::MainPlotsDirectoryName
-                    / Path::global_average_points_vs_game_number_file_name(
-                        game_category));
-      for (const Place& place : PlacesFirstSecondThird) {
-        generate_plot(base_directory / Path::MainPlotsDirectoryName
+              / Path::global_average_points_vs_game_number_file_name(
+                  game_category),
+          players, data};
+      GlobalPlacePercentageVsGameNumberGnuplotFileWriter{
+          base_directory / Path::MainPlotsDirectoryName
+              / Path::global_place_percentage_vs_game_number_file_name(
+                  game_category, {1}),
+          players,
+          data,
+          game_category,
+          {1}};
+    }
+  }
+
+  void write_player_gnuplot_files(
+      const std::experimental::filesystem::path& base_directory,
+      const Player& player, const Settings& settings) const noexcept {
+    std::map<GameCategory, std::experimental::filesystem::path> data_paths;
+    for (const GameCategory game_category : GameCategories) {
+      // Only generate a plot if this player has at least 2 games in this game
+      // category.
+      if (player.number_of_games(game_category) >= 2) {
+        data_paths.insert({game_category,
+                           plotted_data_path(base_directory, player,
+                                             game_category, settings)});
+      }
+    }
+    if (!data_paths.empty()) {
+      IndividualEloRatingVsGameNumberGnuplotFileWriter{
+          base_directory / player.name().directory_name()
+              / Path::PlayerPlotsDirectoryName
+              / Path::PlayerEloRatingVsGameNumberFileName,
+          data_paths, player.lowest_elo_rating(), player.highest_elo_rating()};
+      IndividualAveragePointsVsGameNumberGnuplotFileWriter{
+          base_directory / player.name().directory_name()
+              / Path::PlayerPlotsDirectoryName
+              / Path::PlayerAveragePointsVsGameNumberFileName,
+          data_paths};
+    }
+    if (player.number_of_games(GameCategory::AnyNumberOfPlayers) >= 2) {
+      IndividualPlacePercentageVsGameNumberGnuplotFileWriter{
+          base_directory / player.name().directory_name()
+              / Path::PlayerPlotsDirectoryName
+              / Path::individual_place_percentage_vs_game_number_file_name(
+                  GameCategory::AnyNumberOfPlayers),
+          plotted_data_path(base_directory, player,
+                            GameCategory::AnyNumberOfPlayers, settings),
+          GameCategory::AnyNumberOfPlayers};
+    }
+  }
+
+  std::vector<std::experimental::filesystem::path> global_gnuplot_paths(
+      const std::experimental::filesystem::path& base_directory,
+      const GameCategory game_category) const noexcept {
+    std::vector<std::experimental::filesystem::path> paths{
+        base_directory / Path::MainPlotsDirectoryName
+            / Path::global_elo_rating_vs_game_number_file_name(game_category),
+        base_directory / Path::MainPlotsDirectoryName
+            / Path::global_average_points_vs_game_number_file_name(
+                game_category)};
+    for (const Place& place : PlacesFirstSecondThird) {
+      paths.push_back(base_directory / Path::MainPlotsDirectoryName
                       / Path::global_place_percentage_vs_game_number_file_name(
                           game_category, place));
-      }
     }
-    message("Generated the global plots.");
+    return paths;
   }
 
-  void generate_player_plots(
+  std::vector<std::experimental::filesystem::path> player_gnuplot_paths(
       const std::experimental::filesystem::path& base_directory,
-      const Players& players) const {
-    message("Generating the individual player plots...");
-    for (const Player& player : players) {
-      generate_plot(base_directory / player.name().directory_name()
-                    / Path::PlayerPlotsDirectoryName
-                    / Path::PlayerAveragePointsVsGameNumberFileName);
-      generate_plot(base_directory / player.name().directory_name()
-                    / Path::PlayerPlotsDirectoryName
-                    / Path::PlayerEloRatingVsGameNumberFileName);
-      for (const GameCategory game_category : GameCategories) {
-        generate_plot(
-            base_directory / player.name().directory_name()
+      const Player& player) const noexcept {
+    std::vector<std::experimental::filesystem::path> paths{
+        base_directory / player.name().directory_name()
             / Path::PlayerPlotsDirectoryName
-            / Path::individual_place_percentage_vs_game_number_file_name(
-                game_category));
+            / Path::PlayerAveragePointsVsGameNumberFileName,
+        base_directory / player.name().directory_name()
+            / Path::PlayerPlotsDirectoryName
+            / Path::PlayerEloRatingVsGameNumberFileName};
+    for (const GameCategory game_category : GameCategories) {
+      paths.push_back(
+          base_directory / player.name().directory_name()
+          / Path::PlayerPlotsDirectoryName
+          / Path::individual_place_percentage_vs_game_number_file_name(
+              game_category));
+    }
+    return paths;
+  }
+
+  /// \brief Generate the plots of several Gnuplot files. Files that do not
+  /// exist are skipped. In batch mode, the files are combined into a single
+  /// batch file in the given directory, which is then run by a single Gnuplot
+  /// process. Otherwise, one Gnuplot process is run per file.
+  void generate_plots(
+      const std::vector<std::experimental::filesystem::path>& paths,
+      const bool batch, const std::experimental::filesystem::path& directory,
+      Context& context) const {
+    if (!batch) {
+      for (const std::experimental::filesystem::path& path : paths) {
+        generate_plot(path, context);
+      }
+      return;
+    }
+    std::vector<std::experimental::filesystem::path> existing_paths;
+    for (const std::experimental::filesystem::path& path : paths) {
+      if (std::experimental::filesystem::exists(path)) {
+        existing_paths.push_back(path);
       }
     }
-    message("Generated the individual player plots.");
+    if (!existing_paths.empty()) {
+      GnuplotBatchFileWriter{
+          directory / Path::GnuplotBatchFileName, existing_paths};
+      generate_plot(directory / Path::GnuplotBatchFileName, context);
+    }
   }
 
   /// \brief Generate a plot using Gnuplot. If the path points to a file that
-  /// does not exist, no plot is generated.
-  void generate_plot(const std::experimental::filesystem::path& path) const {
-    if (std::experimental::filesystem::exists(path)) {
+  /// does not exist or if plots are disabled in the settings, no plot is
+  /// generated.
+  void generate_plot(const std::experimental::filesystem::path& path,
+                     Context& context) const {
+    if (context.settings.generate_plots
+        && std::experimental::filesystem::exists(path)) {
       const std::string command{"gnuplot " + path.string()};
+      CATAN_RANKER_TRACE_SPAN(context.tracer, "gnuplot", command);
+      context.profiler.add_gnuplot_processes(1);
       const int outcome{std::system(command.c_str())};
       if (outcome != 0) {
         error("Could not run the command: " + command);
       }
     }
   }
-
-  Table player_table(
-      const Player& player, const GameCategory game_category) const noexcept {
-    Column game_number{"Game#"};
-    Column game_category_game_number{"GameCategory#"};
-    Column player_game_number{"PlayerGame#"};
-    Column player_game_category_game_number{"PlayerCategoryGame#"};
-    Column date{"Date"};
-    Column average_elo_rating{"AvgRating"};
-    Column elo_rating{"CurrentRating"};
-    Column average_points_per_game{"AvgPoints"};
-    Column first_place_percentage{"1stPlace%"};
-    Column second_place_percentage{"2ndPlace%"};
-    Column third_place_percentage{"3rdPlace%"};
-    Column first_or_second_place_percentage{"1stOr2ndPlace%"};
-    Column first_or_second_or_third_place_percentage{"1stOr2ndOr3rdPlace%"};
-    if (!player[game_category].empty()) {
-      for (const PlayerProperties& properties : player[game_category]) {
-        game_number.add_row(properties.game_number());
-        game_category_game_number.add_row(
-            properties.game_category_game_number());
-        player_game_number.add_row(properties.player_game_number());
-        player_game_category_game_number.add_row(
-            properties.player_game_category_game_number());
-        date.add_row(properties.date());
-        average_elo_rating.add_row(properties.average_elo_rating());
-        elo_rating.add_row(properties.elo_rating());
-        average_points_per_game.add_row(
-            properties.average_points_per_game(), 7);
-        first_place_percentage.add_row(properties.place_percentage({1}), 5);
-        second_place_percentage.add_row(properties.place_percentage({2}), 5);
-        third_place_percentage.add_row(properties.place_percentage({3}), 5);
-        first_or_second_place_percentage.add_row(
-            properties.place_percentage({1}) + properties.place_percentage({2}),
-            5);
-        first_or_second_or_third_place_percentage.add_row(
-            properties.place_percentage({1}) + properties.place_percentage({2})
-                + properties.place_percentage({3}),
-            5);
-      }
-    }
-    return {
-        {game_number, game_category_game_number, player_game_number,
-         player_game_category_game_number, date, average_elo_rating, elo_rating,
-         average_points_per_game, first_place_percentage,
-         second_place_percentage, third_place_percentage,
-         first_or_second_place_percentage, first_or_second_or_third_place_percentage}
-    };
-  }
 };
 
 }  // namespace CatanRanker
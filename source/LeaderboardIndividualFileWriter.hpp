@@ -1,8 +1,6 @@
 #pragma once
 
-#include "MarkdownFileWriter.hpp"
-#include "Path.hpp"
-#include "Player.hpp"
+#include "HistoryPageFileWriter.hpp"
 
 namespace CatanRanker {
 
@@ -10,7 +8,7 @@ class LeaderboardIndividualFileWriter : public MarkdownFileWriter {
 public:
   LeaderboardIndividualFileWriter(
       const std::experimental::filesystem::path& base_directory,
-      const Games& games, const Player& player) noexcept
+      const Player& player, const RenderCache& cache) noexcept
     : MarkdownFileWriter(base_directory / player.name().directory_name()
                              / Path::LeaderboardFileName,
                          player.name().value()) {
@@ -23,7 +21,7 @@ public:
     list_link(section_title_games_tables_);
     link_back_to_main_page();
     section(section_title_players_table_);
-    player_table(player);
+    player_table(player, cache);
     link_back_to_top();
     section(section_title_elo_rating_plot_);
     elo_rating_plot();
@@ -42,7 +40,7 @@ public:
     link_back_to_top();
     for (const GameCategory game_category : GameCategories) {
       subsection(label(game_category) + " " + section_title_games_tables_);
-      games_table(games, player, game_category);
+      history_page_links(player, game_category);
       link_back_to_section(section_title_games_tables_);
     }
     blank_line();
@@ -59,7 +57,7 @@ protected:
 
   const std::string section_title_games_tables_{"History"};
 
-  void player_table(const Player& player) noexcept {
+  void player_table(const Player& player, const RenderCache& cache) noexcept {
     Column category{"Category", Column::Alignment::Center};
     Column number_of_games{"Games", Column::Alignment::Center};
     Column elo_rating{"Current Rating", Column::Alignment::Center};
@@ -68,37 +66,40 @@ protected:
     Column first_place{"1st Place", Column::Alignment::Center};
     Column second_place{"2nd Place", Column::Alignment::Center};
     Column third_place{"3rd Place", Column::Alignment::Center};
+    const std::string recent{
+        "Last " + std::to_string(Form::NumberOfGames) + " "};
+    Column recent_average_points_per_game{
+        recent + "Points", Column::Alignment::Center};
+    Column recent_first_place{recent + "1st Place", Column::Alignment::Center};
+    Column recent_elo_rating_change{
+        recent + "Rating Change", Column::Alignment::Center};
+    Column exponential_average_points_per_game{
+        "Weighted Points", Column::Alignment::Center};
     for (const GameCategory game_category : GameCategories) {
-      const std::optional<PlayerProperties> latest{
-          player.latest_properties(game_category)};
-      if (latest.has_value()) {
+      const std::optional<RenderCache::SummaryRow>& row{
+          cache.summary_row(player.name(), game_category)};
+      if (row.has_value()) {
         category.add_row(label(game_category));
-        number_of_games.add_row(
-            latest.value().player_game_category_game_number());
-        elo_rating.add_row(latest.value().elo_rating());
-        average_elo_rating.add_row(latest.value().average_elo_rating());
-        average_points_per_game.add_row(
-            latest.value().average_points_per_game(), 3);
-        const int64_t first_place_count{latest.value().place_count({1})};
-        const int64_t second_place_count{latest.value().place_count({2})};
-        const int64_t third_place_count{latest.value().place_count({3})};
-        const Percentage first_place_percentage{
-            latest.value().place_percentage({1})};
-        const Percentage second_place_percentage{
-            latest.value().place_percentage({2})};
-        const Percentage third_place_percentage{
-            latest.value().place_percentage({3})};
-        first_place.add_row(first_place_percentage.print(0) + " ("
-                            + std::to_string(first_place_count) + ")");
-        second_place.add_row(second_place_percentage.print(0) + " ("
-                             + std::to_string(second_place_count) + ")");
-        third_place.add_row(third_place_percentage.print(0) + " ("
-                            + std::to_string(third_place_count) + ")");
+        number_of_games.add_row(row.value().number_of_games);
+        elo_rating.add_row(row.value().elo_rating);
+        average_elo_rating.add_row(row.value().average_elo_rating);
+        average_points_per_game.add_row(row.value().average_points_per_game);
+        first_place.add_row(row.value().first_place);
+        second_place.add_row(row.value().second_place);
+        third_place.add_row(row.value().third_place);
+        recent_average_points_per_game.add_row(
+            row.value().recent_average_points_per_game);
+        recent_first_place.add_row(row.value().recent_first_place);
+        recent_elo_rating_change.add_row(row.value().recent_elo_rating_change);
+        exponential_average_points_per_game.add_row(
+            row.value().exponential_average_points_per_game);
       }
     }
     const Table data{
         {category, number_of_games, elo_rating, average_elo_rating,
-         average_points_per_game, first_place, second_place, third_place}
+         average_points_per_game, first_place, second_place, third_place,
+         recent_average_points_per_game, recent_first_place,
+         recent_elo_rating_change, exponential_average_points_per_game}
     };
     table(data);
   }
@@ -135,42 +136,13 @@ protected:
     }
   }
 
-  void games_table(const Games& games, const Player& player,
-                   const GameCategory game_category) noexcept {
-    if (player[game_category].empty()) {
-      return;
-    }
-    Column game_number{"Game", Column::Alignment::Center};
-    Column date{"Date", Column::Alignment::Center};
-    Column winning_points{"Points", Column::Alignment::Center};
-    Column number_of_players{"Players", Column::Alignment::Center};
-    Column results{"Results", Column::Alignment::Left};
-    std::size_t counter{0};
-    for (std::vector<Game>::const_reverse_iterator game = games.crbegin();
-         game < games.crend(); ++game) {
-      if ((game_category == GameCategory::AnyNumberOfPlayers
-           || game_category == game->category())
-          && game->participant(player.name())) {
-        ++counter;
-      }
-    }
-    for (std::vector<Game>::const_reverse_iterator game = games.crbegin();
-         game < games.crend(); ++game) {
-      if ((game_category == GameCategory::AnyNumberOfPlayers
-           || game_category == game->category())
-          && game->participant(player.name())) {
-        game_number.add_row(counter);
-        date.add_row(game->date());
-        winning_points.add_row(game->winning_points());
-        number_of_players.add_row(game->number_of_players());
-        results.add_row(game->print_results());
-        --counter;
-      }
+  void history_page_links(
+      const Player& player, const GameCategory game_category) noexcept {
+    for (const std::string& link : HistoryPageFileWriter::links(
+             game_category, static_cast<std::size_t>(
+                                player.number_of_games(game_category)))) {
+      line(link);
     }
-    const Table data{
-        {game_number, date, winning_points, number_of_players, results}
-    };
-    table(data);
   }
 };
 
@@ -1,13 +1,90 @@
-#include "Instructions.hpp"
-#include "Leaderboard.hpp"
+#include "Addition.hpp"
+#include "AllocationHooks.hpp"
+#include "Batch.hpp"
+#include "ProfileFileWriter.hpp"
+#include "Seasons.hpp"
+#include "Server.hpp"
+#include "TraceFileWriter.hpp"
 
 int main(int argc, char* argv[]) {
   const CatanRanker::Instructions instructions(argc, argv);
-  const CatanRanker::TextFileReader file{instructions.games_file()};
-  const CatanRanker::Games games{file};
-  const CatanRanker::Players players{games};
+  if (!instructions.batch_file().empty()) {
+    CatanRanker::TaskScheduler scheduler{
+        static_cast<std::size_t>(instructions.number_of_threads())};
+    const CatanRanker::Batch batch{instructions, scheduler};
+    CatanRanker::message("End of " + CatanRanker::Program::Title + ".");
+    return batch.number_of_failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  CatanRanker::Context context{
+      instructions.settings(), CatanRanker::Profiler{instructions.profile()},
+      CatanRanker::Tracer{!instructions.trace_file().empty()}};
+  // Print and write the profile and the trace of the run.
+  const auto report = [&]() {
+    if (context.profiler.enabled()) {
+      CatanRanker::message(context.profiler.print());
+    }
+    if (!instructions.profile_file().empty()) {
+      CatanRanker::ProfileFileWriter{
+          instructions.profile_file(), context.profiler};
+      CatanRanker::message(
+          "Wrote the profile to: " + instructions.profile_file().string());
+    }
+    if (!instructions.trace_file().empty()) {
+      CatanRanker::TraceFileWriter{instructions.trace_file(), context.tracer};
+      CatanRanker::message(
+          "Wrote the trace to: " + instructions.trace_file().string());
+    }
+  };
+  if (!instructions.added_game().empty()) {
+    const CatanRanker::Addition addition{instructions, context};
+    if (addition.incremental()) {
+      report();
+      CatanRanker::message("End of " + CatanRanker::Program::Title + ".");
+      return EXIT_SUCCESS;
+    }
+  }
+  const CatanRanker::TextFileReader file{[&]() {
+    const CatanRanker::Profiler::Interval interval{
+        context.profiler, CatanRanker::Phase::Read};
+    CATAN_RANKER_TRACE_SPAN(context.tracer, "phase", "Read");
+    return CatanRanker::TextFileReader{instructions.games_file()};
+  }()};
+  CatanRanker::Games games{file, context};
+  CatanRanker::Players players{
+      games, context,
+      instructions.streaming() ? instructions.leaderboard_directory() :
+                                 std::experimental::filesystem::path{}};
+  CatanRanker::TaskScheduler scheduler{
+      static_cast<std::size_t>(instructions.number_of_threads())};
   const CatanRanker::Leaderboard leaderboard{
-      instructions.leaderboard_directory(), games, players};
+      instructions.leaderboard_directory(), games, players, context, scheduler};
+  if (!instructions.leaderboard_directory().empty()) {
+    CatanRanker::CheckpointFileWriter{
+        instructions.leaderboard_directory()
+            / CatanRanker::Path::CheckpointFileName,
+        CatanRanker::FileFingerprint::compute(instructions.games_file()),
+        context.settings, players};
+    CatanRanker::message("Wrote the checkpoint.");
+  }
+  if (!instructions.seasons().empty()) {
+    const CatanRanker::Seasons seasons{
+        CatanRanker::SeasonSchedule{instructions.seasons()}, games, context,
+        scheduler,
+        instructions.streaming() ? instructions.leaderboard_directory() :
+                                   std::experimental::filesystem::path{}};
+    seasons.write(instructions.leaderboard_directory(), context, scheduler);
+  }
+  report();
+  CatanRanker::Queries queries{
+      games, players, context, instructions.games_file()};
+  for (const std::string& query : instructions.queries()) {
+    CatanRanker::print_line(queries.answer(query));
+  }
+  if (instructions.serve()) {
+    CatanRanker::Server server{
+        instructions.socket_file(), instructions.http_port(), queries};
+    server.run();
+  }
   CatanRanker::message("End of " + CatanRanker::Program::Title + ".");
   return EXIT_SUCCESS;
 }
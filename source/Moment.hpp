@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Date.hpp"
+
+namespace CatanRanker {
+
+/// \brief Moment in the history of the games: either the end of a date, after
+/// every game played on or before that date, or the end of a game, after every
+/// game up to and including the game with that game number.
+class Moment {
+public:
+  /// \brief End of a date.
+  Moment(const Date& date) noexcept : date_(date) {}
+
+  /// \brief End of the game with a given game number, starting from 1.
+  Moment(const int64_t game_number) noexcept : game_number_(game_number) {}
+
+  /// \brief Constructor from a YYYY-MM-DD date, such as "2020-03-15", or from a
+  /// game number, such as "250".
+  static Moment parse(const std::string& text) {
+    if (text.find('-') != std::string::npos) {
+      return {Date{text}};
+    }
+    const std::optional<int64_t> game_number{string_to_integer_number(text)};
+    if (!game_number.has_value() || game_number.value() < 1) {
+      error("The moment '" + text
+            + "' is neither a date in the YYYY-MM-DD format nor a game "
+              "number.");
+    }
+    return {game_number.value()};
+  }
+
+  /// \brief End of each month from the month of a date to the month of another
+  /// date, inclusive.
+  static std::vector<Moment> month_ends(const Date& first, const Date& last) {
+    std::vector<Moment> moments;
+    for (Date date = first.end_of_month(); date <= last.end_of_month();
+         date = date.end_of_next_month()) {
+      moments.emplace_back(date);
+    }
+    return moments;
+  }
+
+  /// \brief Whether a game with a given game number and date was played at or
+  /// before this moment.
+  bool includes(const int64_t game_number, const Date& date) const noexcept {
+    if (game_number_.has_value()) {
+      return game_number <= game_number_.value();
+    }
+    return date <= date_;
+  }
+
+  /// \brief Whether a game with a given game number and date was played before
+  /// this moment began: before the date, or before the game.
+  bool precedes(const int64_t game_number, const Date& date) const noexcept {
+    if (game_number_.has_value()) {
+      return game_number < game_number_.value();
+    }
+    return date < date_;
+  }
+
+  /// \brief Whether a period that begins at this moment would begin after
+  /// the end of a period that ends at another moment. Only moments that are
+  /// both dates or both game numbers are compared.
+  bool begins_after(const Moment& other) const noexcept {
+    if (game_number_.has_value() && other.game_number_.has_value()) {
+      return game_number_.value() > other.game_number_.value();
+    }
+    if (!game_number_.has_value() && !other.game_number_.has_value()) {
+      return date_ > other.date_;
+    }
+    return false;
+  }
+
+  /// \brief Date in the YYYY-MM-DD format, or game number.
+  std::string print() const noexcept {
+    if (game_number_.has_value()) {
+      return std::to_string(game_number_.value());
+    }
+    return date_.print();
+  }
+
+private:
+  Date date_;
+
+  std::optional<int64_t> game_number_;
+};
+
+}  // namespace CatanRanker
@@ -10,12 +10,22 @@ const std::experimental::filesystem::path PlayersDirectoryName{"players"};
 
 const std::experimental::filesystem::path MainPlotsDirectoryName{"plots"};
 
+const std::experimental::filesystem::path MainDataDirectoryName{"data"};
+
 const std::experimental::filesystem::path PlayerDataDirectoryName{"data"};
 
 const std::experimental::filesystem::path PlayerPlotsDirectoryName{"plots"};
 
+const std::experimental::filesystem::path HistoryDirectoryName{"history"};
+
 const std::experimental::filesystem::path LeaderboardFileName{"README.md"};
 
+const std::experimental::filesystem::path GnuplotBatchFileName{"batch.gnuplot"};
+
+const std::experimental::filesystem::path CheckpointFileName{"checkpoint.txt"};
+
+const std::experimental::filesystem::path SeasonsDirectoryName{"seasons"};
+
 const std::experimental::filesystem::path PlayerEloRatingVsGameNumberFileName{
     "rating_vs_game_number.gnuplot"};
 
@@ -41,6 +51,37 @@ std::experimental::filesystem::path player_data_file_name(
   return {game_category_file_name(game_category).string() + ".dat"};
 }
 
+/// \brief Name of the directory of the global data files of a game category
+/// in the main data directory.
+std::experimental::filesystem::path global_data_directory_name(
+    const GameCategory game_category) noexcept {
+  return game_category_file_name(game_category);
+}
+
+/// \brief Name of the global data file of a player.
+std::experimental::filesystem::path global_data_file_name(
+    const std::string& player_name) noexcept {
+  return {player_name + ".dat"};
+}
+
+std::experimental::filesystem::path player_binary_data_file_name(
+    const GameCategory game_category) noexcept {
+  return {game_category_file_name(game_category).string() + ".bin"};
+}
+
+std::experimental::filesystem::path player_plot_data_file_name(
+    const GameCategory game_category) noexcept {
+  return {game_category_file_name(game_category).string() + "_plot.dat"};
+}
+
+/// \brief File name of a page of the history of a game category. Pages are
+/// numbered from 1, starting with the oldest games.
+std::experimental::filesystem::path history_page_file_name(
+    const GameCategory game_category, const std::size_t page_number) noexcept {
+  return {game_category_file_name(game_category).string() + "_"
+          + std::to_string(page_number) + ".md"};
+}
+
 std::experimental::filesystem::path global_elo_rating_vs_game_number_file_name(
     const GameCategory game_category) noexcept {
   return {game_category_file_name(game_category).string()
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "PlayerProperties.hpp"
+
+namespace CatanRanker {
+
+/// \brief Statistics of a player in a game category over a period of
+/// consecutive games, such as a season or a month. The properties of a player
+/// hold prefix sums of the points, places, and Elo ratings, so the statistics
+/// of a period are the differences between the properties after the last game
+/// of the period and the properties after the last game before the period,
+/// and take a constant time regardless of the length of the period.
+class PeriodStatistics {
+public:
+  /// \brief The properties before the period are null if the period starts
+  /// with the player's first game, and the properties at the end of the period
+  /// are null if the period ends before the player's first game.
+  PeriodStatistics(const PlayerProperties* const before,
+                   const PlayerProperties* const last) noexcept
+    : before_(before), last_(last) {
+    if (last_ != nullptr) {
+      number_of_games_ = last_->player_game_category_game_number()
+                         - (before_ != nullptr ?
+                                before_->player_game_category_game_number() :
+                                0);
+    }
+  }
+
+  /// \brief Number of games played by the player in the period.
+  constexpr int64_t number_of_games() const noexcept {
+    return number_of_games_;
+  }
+
+  /// \brief Average points per game in the period, adjusted to a 10-point
+  /// game. Requires at least one game in the period.
+  double average_points_per_game() const noexcept {
+    return (last_->total_points()
+            - (before_ != nullptr ? before_->total_points() : 0.0))
+           / number_of_games_;
+  }
+
+  /// \brief Ratio of Nth place finishes in the period. Requires at least one
+  /// game in the period.
+  Percentage place_percentage(const Place place) const noexcept {
+    return {static_cast<double>(
+                last_->place_count(place)
+                - (before_ != nullptr ? before_->place_count(place) : 0))
+            / number_of_games_};
+  }
+
+  /// \brief Average of the Elo ratings after each game of the period. Requires
+  /// at least one game in the period.
+  EloRating average_elo_rating() const noexcept {
+    return {(last_->total_elo_rating()
+             - (before_ != nullptr ? before_->total_elo_rating() : 0.0))
+            / number_of_games_};
+  }
+
+  /// \brief Elo rating at the end of the period minus the Elo rating at its
+  /// beginning, which is the starting Elo rating if the period starts with the
+  /// player's first game. Requires at least one game in the period.
+  double elo_rating_change() const noexcept {
+    return last_->elo_rating().value()
+           - (before_ != nullptr ? before_->elo_rating() : EloRating{}).value();
+  }
+
+private:
+  const PlayerProperties* before_;
+
+  const PlayerProperties* last_;
+
+  int64_t number_of_games_{0};
+};
+
+}  // namespace CatanRanker
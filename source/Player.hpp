@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Games.hpp"
+#include "Moment.hpp"
 #include "PlayerProperties.hpp"
 
 namespace CatanRanker {
@@ -16,62 +17,101 @@ public:
   Player(const PlayerName& name, const std::string& color) noexcept
     : name_(name), color_(color) {}
 
-  /// \brief Update a player with a new game.
-  Player(const Player& player, const Game& game,
-         const std::map<PlayerName, std::map<GameCategory, EloRating>,
-                        PlayerName::sort>& previous_elo_ratings) noexcept
-    : name_(player.name_), color_(player.color_),
-      gnuplot_point_type_(player.gnuplot_point_type_), data_(player.data_) {
-    add_game(game, previous_elo_ratings);
+  /// \brief Create a player who will appear in plots if the color is not
+  /// empty. If the history is not retained, only the latest properties and the
+  /// running aggregates of each game category are kept in memory. Otherwise,
+  /// the history is allocated from the given memory resource, which must
+  /// outlive the player.
+  Player(const PlayerName& name, const std::string& color,
+         const bool retains_history,
+         std::pmr::memory_resource* const resource =
+             std::pmr::get_default_resource()) noexcept
+    : name_(name), color_(color), retains_history_(retains_history),
+      resource_(resource) {}
+
+  /// \brief Restore a player saved in a checkpoint from the latest properties,
+  /// the form, and the lowest and highest Elo ratings of each game category.
+  /// The history is not retained.
+  Player(const PlayerName& name, const std::string& color,
+         const std::map<GameCategory, std::optional<PlayerProperties>>& latest,
+         const std::map<GameCategory, Form>& forms,
+         const std::map<GameCategory, EloRating>& lowest_elo_ratings,
+         const std::map<GameCategory, EloRating>& highest_elo_ratings) noexcept
+    : name_(name), color_(color), retains_history_(false) {
+    for (const GameCategory game_category : GameCategories) {
+      latest_[game_category] = latest.find(game_category)->second;
+      forms_[game_category] = forms.find(game_category)->second;
+      lowest_elo_ratings_[game_category] =
+          lowest_elo_ratings.find(game_category)->second;
+      highest_elo_ratings_[game_category] =
+          highest_elo_ratings.find(game_category)->second;
+    }
   }
 
   const PlayerName& name() const noexcept {
     return name_;
   }
 
-  const std::optional<PlayerProperties> latest_properties(
+  const std::optional<PlayerProperties>& latest_properties(
       const GameCategory game_category) const noexcept {
-    const std::map<GameCategory, std::vector<PlayerProperties>>::const_iterator
-        category_history{data_.find(game_category)};
-    if (category_history != data_.cend() && !category_history->second.empty()) {
-      return category_history->second.back();
+    return latest_.find(game_category)->second;
+  }
+
+  /// \brief Number of games played by this player in a game category.
+  int64_t number_of_games(const GameCategory game_category) const noexcept {
+    const std::optional<PlayerProperties>& latest{
+        latest_properties(game_category)};
+    if (latest.has_value()) {
+      return latest.value().player_game_category_game_number();
     } else {
-      const std::optional<PlayerProperties> no_data;
-      return no_data;
+      return 0;
     }
   }
 
+  /// \brief Latest Elo rating of this player in a game category, or the
+  /// starting Elo rating if this player has no games in that game category.
+  EloRating elo_rating(const GameCategory game_category) const noexcept {
+    const std::optional<PlayerProperties>& latest{
+        latest_properties(game_category)};
+    if (latest.has_value()) {
+      return latest.value().elo_rating();
+    } else {
+      return {};
+    }
+  }
+
+  /// \brief Recent form of this player in a game category.
+  const Form& form(const GameCategory game_category) const noexcept {
+    return forms_.find(game_category)->second;
+  }
+
+  /// \brief Whether the full history of this player is kept in memory. If not,
+  /// the history is only available through the player's data files.
+  constexpr bool retains_history() const noexcept {
+    return retains_history_;
+  }
+
   const std::string& color() const noexcept {
     return color_;
   }
 
+  /// \brief Set the color of this player in plots. Empty if this player does
+  /// not appear in plots.
+  void set_color(const std::string& color) noexcept {
+    color_ = color;
+  }
+
   const int8_t gnuplot_point_type() const noexcept {
     return gnuplot_point_type_;
   }
 
   EloRating lowest_elo_rating(const GameCategory game_category) const noexcept {
-    EloRating lowest;
-    const std::map<GameCategory, std::vector<PlayerProperties>>::const_iterator
-        found{data_.find(game_category)};
-    for (const PlayerProperties& player_properties : found->second) {
-      if (lowest > player_properties.elo_rating()) {
-        lowest = player_properties.elo_rating();
-      }
-    }
-    return lowest;
+    return lowest_elo_ratings_.find(game_category)->second;
   }
 
   EloRating highest_elo_rating(
       const GameCategory game_category) const noexcept {
-    EloRating highest;
-    const std::map<GameCategory, std::vector<PlayerProperties>>::const_iterator
-        found{data_.find(game_category)};
-    for (const PlayerProperties& player_properties : found->second) {
-      if (highest < player_properties.elo_rating()) {
-        highest = player_properties.elo_rating();
-      }
-    }
-    return highest;
+    return highest_elo_ratings_.find(game_category)->second;
   }
 
   EloRating lowest_elo_rating() const noexcept {
@@ -97,15 +137,28 @@ public:
   }
 
   std::string print(const GameCategory game_category) const noexcept {
-    const std::map<GameCategory, std::vector<PlayerProperties>>::const_iterator
-        category_history{data_.find(game_category)};
-    if (category_history != data_.cend() && !category_history->second.empty()) {
-      return name_.value() + " : " + category_history->second.back().print();
+    const std::optional<PlayerProperties>& latest{
+        latest_properties(game_category)};
+    if (latest.has_value()) {
+      return name_.value() + " : " + latest.value().print();
     } else {
       return {};
     }
   }
 
+  /// \brief Update this player with a new game. Nothing happens if this player
+  /// is not a participant in the game. The previous Elo ratings must contain
+  /// every participant in the game.
+  void add_game(
+      const Game& game,
+      const std::map<PlayerName, std::map<GameCategory, EloRating>,
+                     PlayerName::sort>& previous_elo_ratings) noexcept {
+    if (game.participant(name_)) {
+      add_game(game, game.category(), previous_elo_ratings);
+      add_game(game, GameCategory::AnyNumberOfPlayers, previous_elo_ratings);
+    }
+  }
+
   bool operator==(const Player& other) const noexcept {
     return name_ == other.name_;
   }
@@ -114,6 +167,8 @@ public:
     return name_ != other.name_;
   }
 
+  /// \brief History of this player in a game category. Empty if the history is
+  /// not retained.
   const std::vector<PlayerProperties>& operator[](
       const GameCategory game_category) const noexcept {
     const std::map<GameCategory, std::vector<PlayerProperties>>::const_iterator
@@ -121,11 +176,56 @@ public:
     return found->second;
   }
 
+  /// \brief Properties of this player in a game category at a moment: after
+  /// this player's last game in that game category at or before that moment.
+  /// Null if this player had no such game or if the history is not retained.
+  /// The history is sorted by game number and by date, so it is binary
+  /// searched.
+  const PlayerProperties* properties(
+      const GameCategory game_category, const Moment& moment) const noexcept {
+    const std::vector<PlayerProperties>& history{operator[](game_category)};
+    const std::vector<PlayerProperties>::const_iterator end{
+        std::partition_point(history.cbegin(), history.cend(),
+                             [&moment](const PlayerProperties& properties) {
+                               return moment.includes(properties.game_number(),
+                                                      properties.date());
+                             })};
+    return end != history.cbegin() ? &*(end - 1) : nullptr;
+  }
+
+  /// \brief Properties of this player in a game category just before a
+  /// moment began: after this player's last game in that game category that
+  /// precedes that moment. Null if this player had no such game or if the
+  /// history is not retained.
+  const PlayerProperties* properties_before(
+      const GameCategory game_category, const Moment& moment) const noexcept {
+    const std::vector<PlayerProperties>& history{operator[](game_category)};
+    const std::vector<PlayerProperties>::const_iterator end{
+        std::partition_point(history.cbegin(), history.cend(),
+                             [&moment](const PlayerProperties& properties) {
+                               return moment.precedes(properties.game_number(),
+                                                      properties.date());
+                             })};
+    return end != history.cbegin() ? &*(end - 1) : nullptr;
+  }
+
   struct sort {
+    using is_transparent = void;
+
     bool operator()(
         const Player& player_1, const Player& player_2) const noexcept {
       return PlayerName::sort()(player_1.name(), player_2.name());
     }
+
+    bool operator()(
+        const Player& player, const PlayerName& player_name) const noexcept {
+      return PlayerName::sort()(player.name(), player_name);
+    }
+
+    bool operator()(
+        const PlayerName& player_name, const Player& player) const noexcept {
+      return PlayerName::sort()(player_name, player.name());
+    }
   };
 
   struct const_iterator
@@ -164,6 +264,13 @@ private:
 
   int8_t gnuplot_point_type_{0};
 
+  bool retains_history_{true};
+
+  /// \brief Memory resource from which the history is allocated. The latest
+  /// properties are replaced after every game, so they are allocated from the
+  /// default memory resource instead.
+  std::pmr::memory_resource* resource_{std::pmr::get_default_resource()};
+
   std::map<GameCategory, std::vector<PlayerProperties>> data_{
       {GameCategory::AnyNumberOfPlayers,  {}},
       {GameCategory::ThreeToFourPlayers,  {}},
@@ -171,15 +278,33 @@ private:
       {GameCategory::SevenToEightPlayers, {}}
   };
 
-  void add_game(
-      const Game& game,
-      const std::map<PlayerName, std::map<GameCategory, EloRating>,
-                     PlayerName::sort>& previous_elo_ratings) noexcept {
-    if (game.participant(name_)) {
-      add_game(game, game.category(), previous_elo_ratings);
-      add_game(game, GameCategory::AnyNumberOfPlayers, previous_elo_ratings);
-    }
-  }
+  std::map<GameCategory, std::optional<PlayerProperties>> latest_{
+      {GameCategory::AnyNumberOfPlayers,  {}},
+      {GameCategory::ThreeToFourPlayers,  {}},
+      {GameCategory::FiveToSixPlayers,    {}},
+      {GameCategory::SevenToEightPlayers, {}}
+  };
+
+  std::map<GameCategory, Form> forms_{
+      {GameCategory::AnyNumberOfPlayers,  {}},
+      {GameCategory::ThreeToFourPlayers,  {}},
+      {GameCategory::FiveToSixPlayers,    {}},
+      {GameCategory::SevenToEightPlayers, {}}
+  };
+
+  std::map<GameCategory, EloRating> lowest_elo_ratings_{
+      {GameCategory::AnyNumberOfPlayers,  {}},
+      {GameCategory::ThreeToFourPlayers,  {}},
+      {GameCategory::FiveToSixPlayers,    {}},
+      {GameCategory::SevenToEightPlayers, {}}
+  };
+
+  std::map<GameCategory, EloRating> highest_elo_ratings_{
+      {GameCategory::AnyNumberOfPlayers,  {}},
+      {GameCategory::ThreeToFourPlayers,  {}},
+      {GameCategory::FiveToSixPlayers,    {}},
+      {GameCategory::SevenToEightPlayers, {}}
+  };
 
   void add_game(
       const Game& game, const GameCategory game_category,
@@ -187,7 +312,7 @@ private:
                      PlayerName::sort>& previous_elo_ratings) noexcept {
     // Get appropriate previous Elo ratings.
     std::map<PlayerName, EloRating, PlayerName::sort> previous;
-    for (const std::pair<PlayerName, std::map<GameCategory, EloRating>>
+    for (const std::pair<const PlayerName, std::map<GameCategory, EloRating>>&
              previous_elo_rating : previous_elo_ratings) {
       const std::map<GameCategory, EloRating>::const_iterator found{
           previous_elo_rating.second.find(game_category)};
@@ -198,29 +323,33 @@ private:
               + " is missing from the previous Elo ratings map.");
       }
     }
-    // Add new game.
-    const std::map<GameCategory, std::vector<PlayerProperties>>::iterator
-        history_any_number_of_players{
-            data_.find(GameCategory::AnyNumberOfPlayers)};
-    const std::map<GameCategory, std::vector<PlayerProperties>>::iterator
-        history_same_game_category{data_.find(game_category)};
-    if (history_any_number_of_players != data_.cend()
-        && history_same_game_category != data_.end()) {
-      if (history_any_number_of_players->second.empty()
-          && history_same_game_category->second.empty()) {
-        history_same_game_category->second.emplace_back(
-            name_, game_category, game, previous);
-      } else if (!history_any_number_of_players->second.empty()
-                 && history_same_game_category->second.empty()) {
-        history_same_game_category->second.emplace_back(
-            name_, game_category, game, previous,
-            history_any_number_of_players->second.back());
-      } else {
-        history_same_game_category->second.emplace_back(
-            name_, game_category, game, previous,
-            history_any_number_of_players->second.back(),
-            history_same_game_category->second.back());
-      }
+    // Update the recent form, which only keeps the last few games.
+    Form& form{forms_[game_category]};
+    form.add(game.adjusted_points(name_).value_or(0.0),
+             game.place(name_) == Place{1},
+             previous.find(name_)->second.value());
+    // Add new game. The previous properties in any game category must be read
+    // before they are replaced, which is why the specific game category is
+    // always updated before the "any number of players" game category.
+    std::optional<PlayerProperties>& latest{latest_[game_category]};
+    latest = PlayerProperties{name_,
+                              game_category,
+                              game,
+                              previous,
+                              form,
+                              latest_[GameCategory::AnyNumberOfPlayers],
+                              latest};
+    if (retains_history_) {
+      data_[game_category].emplace_back(latest.value(), resource_);
+    }
+    // Update the running aggregates.
+    EloRating& lowest{lowest_elo_ratings_[game_category]};
+    if (lowest > latest.value().elo_rating()) {
+      lowest = latest.value().elo_rating();
+    }
+    EloRating& highest{highest_elo_ratings_[game_category]};
+    if (highest < latest.value().elo_rating()) {
+      highest = latest.value().elo_rating();
     }
   }
 };
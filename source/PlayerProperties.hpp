@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EloRating.hpp"
+#include "Form.hpp"
 #include "Percentage.hpp"
 
 namespace CatanRanker {
@@ -9,11 +10,14 @@ class PlayerProperties {
 public:
   PlayerProperties() noexcept {}
 
+  /// \brief Properties of a player after a game. The form of the player in
+  /// the game category must already include the game.
   PlayerProperties(
       const PlayerName& name, const GameCategory game_category,
       const Game& game,
       const std::map<PlayerName, EloRating, PlayerName::sort>&
           previous_elo_ratings,
+      const Form& form,
       const std::optional<PlayerProperties>& previous_any_number_of_players =
           std::optional<PlayerProperties>{},
       const std::optional<PlayerProperties>& previous_same_game_category =
@@ -27,6 +31,54 @@ public:
     initialize_place_percentages();
     initialize_elo_rating(name, game, previous_elo_ratings);
     initialize_average_elo_rating(previous_same_game_category);
+    initialize_form(form);
+  }
+
+  /// \brief Copy some player properties into storage allocated from a given
+  /// memory resource, which must outlive the copy.
+  PlayerProperties(const PlayerProperties& other,
+                   std::pmr::memory_resource* const resource) noexcept
+    : game_index_(other.game_index_),
+      game_category_game_index_(other.game_category_game_index_),
+      player_game_index_(other.player_game_index_),
+      player_game_category_game_index_(other.player_game_category_game_index_),
+      date_(other.date_),
+      average_points_per_game_(other.average_points_per_game_),
+      place_counts_(other.place_counts_, resource),
+      place_percentages_(other.place_percentages_, resource),
+      elo_rating_(other.elo_rating_),
+      average_elo_rating_(other.average_elo_rating_),
+      total_points_(other.total_points_),
+      total_elo_rating_(other.total_elo_rating_),
+      recent_average_points_per_game_(other.recent_average_points_per_game_),
+      recent_first_place_percentage_(other.recent_first_place_percentage_),
+      recent_elo_rating_change_(other.recent_elo_rating_change_),
+      exponential_average_points_per_game_(
+          other.exponential_average_points_per_game_) {}
+
+  /// \brief Restore some player properties saved in a checkpoint. The place
+  /// percentages are recomputed from the place counts, and the recent form is
+  /// recomputed from the saved form of the player.
+  PlayerProperties(const int64_t game_number,
+                   const int64_t game_category_game_number,
+                   const int64_t player_game_number,
+                   const int64_t player_game_category_game_number,
+                   const Date& date, const double average_points_per_game,
+                   const std::map<Place, int64_t, Place::sort>& place_counts,
+                   const EloRating& elo_rating,
+                   const EloRating& average_elo_rating,
+                   const double total_points,
+                   const double total_elo_rating, const Form& form) noexcept
+    : game_index_(game_number - 1),
+      game_category_game_index_(game_category_game_number - 1),
+      player_game_index_(player_game_number - 1),
+      player_game_category_game_index_(player_game_category_game_number - 1),
+      date_(date), average_points_per_game_(average_points_per_game),
+      place_counts_(place_counts.cbegin(), place_counts.cend()),
+      elo_rating_(elo_rating), average_elo_rating_(average_elo_rating),
+      total_points_(total_points), total_elo_rating_(total_elo_rating) {
+    initialize_place_percentages();
+    initialize_form(form);
   }
 
   /// \brief Game number of this game.
@@ -59,7 +111,7 @@ public:
 
   /// \brief Number of Nth place finishes.
   int64_t place_count(const Place place) const noexcept {
-    const std::map<Place, int64_t, Place::sort>::const_iterator found{
+    const std::pmr::map<Place, int64_t, Place::sort>::const_iterator found{
         place_counts_.find(place)};
     if (found != place_counts_.cend()) {
       return found->second;
@@ -68,9 +120,15 @@ public:
     }
   }
 
+  /// \brief Number of finishes in each place that this player has finished in.
+  const std::pmr::map<Place, int64_t, Place::sort>&
+  place_counts() const noexcept {
+    return place_counts_;
+  }
+
   /// \brief Ratio of Nth place finishes.
   Percentage place_percentage(const Place place) const noexcept {
-    const std::map<Place, Percentage, Place::sort>::const_iterator found{
+    const std::pmr::map<Place, Percentage, Place::sort>::const_iterator found{
         place_percentages_.find(place)};
     if (found != place_percentages_.cend()) {
       return found->second;
@@ -87,6 +145,43 @@ public:
     return average_elo_rating_;
   }
 
+  /// \brief Sum of the adjusted points of this player's games in this game's
+  /// game category so far. The difference between the totals of two games is
+  /// the sum over the games after the first one up to the second one.
+  constexpr double total_points() const noexcept {
+    return total_points_;
+  }
+
+  /// \brief Sum of the Elo ratings of this player after each of this player's
+  /// games in this game's game category so far.
+  constexpr double total_elo_rating() const noexcept {
+    return total_elo_rating_;
+  }
+
+  /// \brief Average points per game over this player's last few games in this
+  /// game's game category, adjusted to a 10-point game.
+  constexpr double recent_average_points_per_game() const noexcept {
+    return recent_average_points_per_game_;
+  }
+
+  /// \brief Ratio of 1st place finishes over this player's last few games in
+  /// this game's game category.
+  constexpr const Percentage& recent_first_place_percentage() const noexcept {
+    return recent_first_place_percentage_;
+  }
+
+  /// \brief Change of the Elo rating over this player's last few games in this
+  /// game's game category.
+  constexpr double recent_elo_rating_change() const noexcept {
+    return recent_elo_rating_change_;
+  }
+
+  /// \brief Exponentially weighted moving average of the points per game in
+  /// this game's game category, adjusted to a 10-point game.
+  constexpr double exponential_average_points_per_game() const noexcept {
+    return exponential_average_points_per_game_;
+  }
+
   std::string print() const noexcept {
     return std::to_string(player_game_category_game_number()) + " games , "
            + average_elo_rating_.print() + " average rating , "
@@ -121,14 +216,30 @@ private:
   /// adjusted to a 10-point game.
   double average_points_per_game_{0.0};
 
-  std::map<Place, int64_t, Place::sort> place_counts_;
+  std::pmr::map<Place, int64_t, Place::sort> place_counts_;
 
-  std::map<Place, Percentage, Place::sort> place_percentages_;
+  std::pmr::map<Place, Percentage, Place::sort> place_percentages_;
 
   EloRating elo_rating_;
 
   EloRating average_elo_rating_;
 
+  /// \brief Prefix sums from which the statistics of any range of games are
+  /// obtained from the properties of the games at the ends of the range. The
+  /// place counts are prefix sums as well.
+  double total_points_{0.0};
+
+  double total_elo_rating_{0.0};
+
+  /// \brief Recent form over the last Form::NumberOfGames games.
+  double recent_average_points_per_game_{0.0};
+
+  Percentage recent_first_place_percentage_;
+
+  double recent_elo_rating_change_{0.0};
+
+  double exponential_average_points_per_game_{0.0};
+
   void initialize_game_category_game_index(
       const GameCategory game_category, const Game& game) noexcept {
     if (game_category == GameCategory::AnyNumberOfPlayers) {
@@ -170,8 +281,11 @@ private:
                        .player_game_category_game_number()
              + found_points.value())
             / player_game_category_game_number();
+        total_points_ = previous_same_game_category.value().total_points_
+                        + found_points.value();
       } else {
         average_points_per_game_ = found_points.value();
+        total_points_ = found_points.value();
       }
     } else {
       error("Player " + name.value()
@@ -187,7 +301,7 @@ private:
     }
     const std::optional<Place> found_place{game.place(name)};
     if (found_place.has_value()) {
-      const std::map<Place, int64_t, Place::sort>::iterator element{
+      const std::pmr::map<Place, int64_t, Place::sort>::iterator element{
           place_counts_.find(found_place.value())};
       if (element != place_counts_.end()) {
         ++(element->second);
@@ -224,10 +338,20 @@ private:
                      .player_game_category_game_number()
            + elo_rating_)
           / (player_game_category_game_number());
+      total_elo_rating_ = previous_same_game_category.value().total_elo_rating_
+                          + elo_rating_.value();
     } else {
       average_elo_rating_ = elo_rating_;
+      total_elo_rating_ = elo_rating_.value();
     }
   }
+
+  void initialize_form(const Form& form) noexcept {
+    recent_average_points_per_game_ = form.average_points_per_game();
+    recent_first_place_percentage_ = {form.first_place_ratio()};
+    recent_elo_rating_change_ = form.elo_rating_change(elo_rating_.value());
+    exponential_average_points_per_game_ = form.exponential_average_points();
+  }
 };
 
 }  // namespace CatanRanker
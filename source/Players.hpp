@@ -1,19 +1,43 @@
 #pragma once
 
+#include "DataFileStream.hpp"
 #include "Player.hpp"
 
 namespace CatanRanker {
 
 class Players {
 public:
-  Players(const Games& games) noexcept {
+  /// \brief Compute every player's history from the games. If a streaming
+  /// directory is given, the history of each player is not kept in memory and
+  /// is instead appended to the player data files in that leaderboard directory
+  /// as it is computed, so that memory usage does not grow with the number of
+  /// games. Binary data files are streamed as well if requested in the
+  /// settings.
+  Players(const Games& games, Context& context,
+          const std::experimental::filesystem::path& streaming_directory =
+              {})
+    : Players(games, context, &context.arena, streaming_directory) {}
+
+  /// \brief Compute every player's history from the games, allocating the
+  /// histories from a given memory resource instead of the arena of the
+  /// context. The memory resource must outlive the players. The players of
+  /// several seasons can then be computed concurrently with the same context,
+  /// each from its own memory resource.
+  Players(const Games& games, Context& context,
+          std::pmr::memory_resource* const resource,
+          const std::experimental::filesystem::path& streaming_directory =
+              {})
+    : streamed_(!streaming_directory.empty()) {
+    const Profiler::Interval interval{context.profiler, Phase::Rate};
+    CATAN_RANKER_TRACE_SPAN(context.tracer, "phase", "Rate");
     // Obtain the player names and their total number of games played.
-    std::map<PlayerName, int64_t> player_names_and_number_of_games;
+    std::map<PlayerName, int64_t, PlayerName::sort>
+        player_names_and_number_of_games;
     for (const Game& game : games) {
-      const std::set<PlayerName, PlayerName::sort> game_player_names{
+      const std::pmr::set<PlayerName, PlayerName::sort>& game_player_names{
           game.player_names()};
       for (const PlayerName& player_name : game_player_names) {
-        const std::map<PlayerName, int64_t>::iterator found{
+        const std::map<PlayerName, int64_t, PlayerName::sort>::iterator found{
             player_names_and_number_of_games.find(player_name)};
         if (found != player_names_and_number_of_games.end()) {
           ++found->second;
@@ -22,61 +46,131 @@ public:
         }
       }
     }
-    std::multimap<int64_t, PlayerName, std::greater<int64_t>>
-        number_of_games_and_player_names;
-    for (const std::pair<const PlayerName, int64_t>&
-             player_name_and_number_of_games :
-         player_names_and_number_of_games) {
-      number_of_games_and_player_names.insert(
-          {player_name_and_number_of_games.second,
-           player_name_and_number_of_games.first});
-    }
     // Initialize the players with a player name and color.
-    std::size_t counter{0};
-    for (const std::pair<const int64_t, PlayerName>&
-             number_of_games_and_player_name :
-         number_of_games_and_player_names) {
-      // Only assign a color to a few players with the most games.
-      if (counter < ColorSequence.size()) {
-        data_.insert({number_of_games_and_player_name.second, color(counter)});
-      } else {
-        data_.insert({number_of_games_and_player_name.second});
-      }
-      ++counter;
+    const std::map<PlayerName, std::string, PlayerName::sort> player_colors{
+        colors(player_names_and_number_of_games)};
+    for (const std::pair<const PlayerName, std::string>& player_color :
+         player_colors) {
+      data_.insert(
+          {player_color.first, player_color.second, !streamed_, resource});
+    }
+    // Update the participants of each game one game at a time.
+    std::optional<DataFileStream> stream;
+    if (streamed_) {
+      stream.emplace(
+          streaming_directory, context.settings.binary_data_files);
     }
-    // Update all the players one game at a time.
     for (const Game& game : games) {
-      // Obtain each player's previous Elo ratings.
-      // These are needed for updating each player's Elo rating after the
-      // current game.
-      std::map<PlayerName, std::map<GameCategory, EloRating>, PlayerName::sort>
-          previous_elo_ratings;
-      for (const Player& player : data_) {
-        std::map<GameCategory, EloRating> previous_elo_rating;
-        for (const GameCategory game_category :
-             {GameCategory::AnyNumberOfPlayers, game.category()}) {
-          if (player[game_category].empty()) {
-            previous_elo_rating.insert({game_category, {}});
-          } else {
-            previous_elo_rating.insert(
-                {game_category, player[game_category].back().elo_rating()});
-          }
-        }
-        previous_elo_ratings.insert({player.name(), previous_elo_rating});
+      update(game, context, stream);
+    }
+    if (stream.has_value()) {
+      stream.reset();
+      message("Wrote the data files while computing the player histories.");
+    }
+    message("Computed the histories of " + std::to_string(data_.size())
+            + " players.");
+    verbose([&]() { return print(); });
+  }
+
+  /// \brief Restore the players saved in a checkpoint. Their histories are not
+  /// kept in memory: they are only available through the player data files of
+  /// the leaderboard that the checkpoint belongs to.
+  Players(std::vector<Player> players) noexcept : streamed_(true) {
+    for (Player& player : players) {
+      data_.insert(std::move(player));
+    }
+  }
+
+  /// \brief Apply the game at an index of the games, which was just added to
+  /// them. If it is the latest game, only its participants are updated, and
+  /// participants who have no games yet are added. Otherwise, the history of
+  /// every player is recomputed from the games into a new arena owned by the
+  /// players, and the arena of the previous histories is released, so that
+  /// recomputing the histories repeatedly does not grow the memory usage.
+  void add(const Games& games, const std::size_t index, Context& context) {
+    if (streamed_) {
+      error("Games cannot be added to player histories that are streamed to "
+            "the data files.");
+    }
+    if (index + 1 < games.size()) {
+      std::unique_ptr<std::pmr::monotonic_buffer_resource> arena{
+          std::make_unique<std::pmr::monotonic_buffer_resource>()};
+      Players players{games, context, arena.get()};
+      // The previous histories are destroyed before their arena is released.
+      data_ = std::move(players.data_);
+      arena_ = std::move(arena);
+      return;
+    }
+    add(games[index], context);
+  }
+
+  /// \brief Apply a game that is later than every game already applied to the
+  /// players. Participants who have no games yet are added without a color.
+  void add(const Game& game, Context& context) noexcept {
+    for (const PlayerName& player_name : game) {
+      if (data_.find(player_name) == data_.cend()) {
+        data_.insert({player_name, std::string{}, !streamed_,
+                      arena_ ? arena_.get() : &context.arena});
+      }
+    }
+    std::optional<DataFileStream> no_stream;
+    update(game, context, no_stream);
+  }
+
+  /// \brief Assign each player the color that would be assigned to them if the
+  /// players were computed from the games. Colors are assigned to the players
+  /// with the most games, so applying a game can change them. Return whether
+  /// any color changed.
+  bool assign_colors() noexcept {
+    std::map<PlayerName, int64_t, PlayerName::sort> numbers_of_games;
+    for (const Player& player : data_) {
+      numbers_of_games.insert(
+          {player.name(),
+           player.number_of_games(GameCategory::AnyNumberOfPlayers)});
+    }
+    bool changed{false};
+    for (const std::pair<const PlayerName, std::string>& player_color :
+         colors(numbers_of_games)) {
+      if (find(player_color.first).color() != player_color.second) {
+        std::set<Player, Player::sort>::node_type node{
+            data_.extract(data_.find(player_color.first))};
+        node.value().set_color(player_color.second);
+        data_.insert(std::move(node));
+        changed = true;
       }
-      // Update each player with the current game.
-      std::set<Player, Player::sort> updated_data;
-      for (const Player& player : data_) {
-        updated_data.emplace(player, game, previous_elo_ratings);
+    }
+    return changed;
+  }
+
+  /// \brief Number of games in a game category, which is the number within
+  /// the game category of the latest game that any player participated in.
+  int64_t number_of_games(const GameCategory game_category) const noexcept {
+    int64_t number{0};
+    for (const Player& player : data_) {
+      const std::optional<PlayerProperties>& latest{
+          player.latest_properties(game_category)};
+      if (latest.has_value()
+          && number < latest.value().game_category_game_number()) {
+        number = latest.value().game_category_game_number();
       }
-      data_ = updated_data;
     }
-    message(print());
+    return number;
+  }
+
+  /// \brief Whether the player histories were streamed to the player data files
+  /// instead of being kept in memory.
+  constexpr bool streamed() const noexcept {
+    return streamed_;
+  }
+
+  /// \brief Whether a player has played any game.
+  bool contains(const PlayerName& name) const noexcept {
+    return data_.find(name) != data_.cend();
   }
 
   const Player& find(const PlayerName& name) const {
     const std::set<Player, Player::sort>::const_iterator datum{
-        data_.find({name})};
+        data_.find(name)};
     if (datum != data_.cend()) {
       return *datum;
     } else {
@@ -111,12 +205,12 @@ public:
     std::stringstream stream;
     stream << "There are " << data_.size() << " players:";
     for (const Player& player : data_) {
-      stream << std::endl << "- " << player.name().value();
+      stream << '\n' << "- " << player.name().value();
     }
-    stream << std::endl << print(GameCategory::AnyNumberOfPlayers);
-    stream << std::endl << print(GameCategory::ThreeToFourPlayers);
-    stream << std::endl << print(GameCategory::FiveToSixPlayers);
-    stream << std::endl << print(GameCategory::SevenToEightPlayers);
+    stream << '\n' << print(GameCategory::AnyNumberOfPlayers);
+    stream << '\n' << print(GameCategory::ThreeToFourPlayers);
+    stream << '\n' << print(GameCategory::FiveToSixPlayers);
+    stream << '\n' << print(GameCategory::SevenToEightPlayers);
     return stream.str();
   }
 
@@ -152,8 +246,84 @@ public:
   }
 
 private:
+  bool streamed_{false};
+
+  /// \brief Arena from which the histories are allocated once they have been
+  /// recomputed by adding a game earlier than the latest game. Null until
+  /// then, in which case the histories are allocated from the memory resource
+  /// given to the constructor. Declared before the players so that it
+  /// outlives them.
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+
   std::set<Player, Player::sort> data_;
 
+  /// \brief Update the participants of a game, which must be later than every
+  /// game already applied to the players. The latest properties of each
+  /// participant are appended to the data files if a stream is given.
+  void update(const Game& game, Context& context,
+              std::optional<DataFileStream>& stream) noexcept {
+    // Obtain each participant's previous Elo ratings.
+    // These are needed for updating each participant's Elo rating after the
+    // current game.
+    std::map<PlayerName, std::map<GameCategory, EloRating>, PlayerName::sort>
+        previous_elo_ratings;
+    for (const PlayerName& player_name : game) {
+      const Player& player{find(player_name)};
+      previous_elo_ratings.insert(
+          {player_name,
+           {{GameCategory::AnyNumberOfPlayers,
+             player.elo_rating(GameCategory::AnyNumberOfPlayers)},
+            {game.category(), player.elo_rating(game.category())}}});
+    }
+    // Update each participant with the current game. Players are extracted
+    // from the set and reinserted so that they can be updated in place.
+    for (const PlayerName& player_name : game) {
+      std::set<Player, Player::sort>::node_type node{
+          data_.extract(data_.find(player_name))};
+      node.value().add_game(game, previous_elo_ratings);
+      if (stream.has_value()) {
+        for (const GameCategory game_category :
+             {game.category(), GameCategory::AnyNumberOfPlayers}) {
+          stream.value().add(
+              player_name, game_category,
+              node.value().latest_properties(game_category).value());
+        }
+      }
+      data_.insert(std::move(node));
+    }
+    // Each participant is updated in the game's category and in the "any
+    // number of players" category.
+    context.profiler.add_rating_updates(2 * game.number_of_players());
+  }
+
+  /// \brief Color of each player given the number of games of each player.
+  /// Only a few players with the most games are assigned a color; ties are
+  /// broken by name. The other players have no color.
+  static std::map<PlayerName, std::string, PlayerName::sort> colors(
+      const std::map<PlayerName, int64_t, PlayerName::sort>&
+          player_names_and_number_of_games) noexcept {
+    std::multimap<int64_t, PlayerName, std::greater<int64_t>>
+        number_of_games_and_player_names;
+    for (const std::pair<const PlayerName, int64_t>&
+             player_name_and_number_of_games :
+         player_names_and_number_of_games) {
+      number_of_games_and_player_names.insert(
+          {player_name_and_number_of_games.second,
+           player_name_and_number_of_games.first});
+    }
+    std::map<PlayerName, std::string, PlayerName::sort> player_colors;
+    std::size_t counter{0};
+    for (const std::pair<const int64_t, PlayerName>&
+             number_of_games_and_player_name :
+         number_of_games_and_player_names) {
+      player_colors.insert(
+          {number_of_games_and_player_name.second,
+           counter < ColorSequence.size() ? color(counter) : std::string{}});
+      ++counter;
+    }
+    return player_colors;
+  }
+
   std::string print(const GameCategory game_category) const noexcept {
     std::stringstream stream;
     switch (game_category) {
@@ -173,7 +343,7 @@ private:
     for (const Player& datum : data_) {
       const std::string text{datum.print(game_category)};
       if (!text.empty()) {
-        stream << std::endl << "- " << text;
+        stream << '\n' << "- " << text;
       }
     }
     return stream.str();
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "DataFileReader.hpp"
+#include "DataFileWriter.hpp"
+#include "Downsampling.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writer of a downsampled copy of a player data file for plotting. The
+/// copy has the same format as the original but only keeps a bounded number of
+/// rows, so that the time taken to generate a plot does not grow with the
+/// number of games. Each plotted series is downsampled independently with the
+/// Largest-Triangle-Three-Buckets algorithm and the union of the kept rows is
+/// written, so every plotted series keeps its visual shape.
+class PlotDataFileWriter : public TextFileWriter {
+public:
+  PlotDataFileWriter(const std::experimental::filesystem::path& path,
+                     const DataFileReader& data,
+                     const std::size_t maximum_number_of_rows) noexcept
+    : TextFileWriter(path) {
+    std::string text{DataFileWriter::header()};
+    for (const std::size_t row_index : rows(data, maximum_number_of_rows)) {
+      text += "\n" + data.row(row_index);
+    }
+    line(text);
+    blank_line();
+  }
+
+private:
+  /// \brief Columns of the data files that are plotted: the current rating,
+  /// the average points per game, and the 1st, 2nd, and 3rd place
+  /// percentages.
+  static constexpr std::array<std::size_t, 5> YColumns{7, 8, 9, 10, 11};
+
+  static std::set<std::size_t> rows(
+      const DataFileReader& data,
+      const std::size_t maximum_number_of_rows) noexcept {
+    std::set<std::size_t> kept;
+    if (data.number_of_rows() <= maximum_number_of_rows) {
+      for (std::size_t row_index = 0; row_index < data.number_of_rows();
+           ++row_index) {
+        kept.insert(row_index);
+      }
+      return kept;
+    }
+    // The plots use the player's own game numbers as their horizontal axis,
+    // and the player's game number within the game category increases by 1
+    // from each row to the next, so the series are downsampled against the
+    // row index. The buckets are then evenly spaced along the plotted axis
+    // even if the player's games are spread unevenly among every game.
+    std::vector<double> x;
+    x.reserve(data.number_of_rows());
+    for (std::size_t row_index = 0; row_index < data.number_of_rows();
+         ++row_index) {
+      x.push_back(static_cast<double>(row_index));
+    }
+    for (const std::size_t y_column : YColumns) {
+      std::vector<double> y;
+      y.reserve(data.number_of_rows());
+      for (std::size_t row_index = 0; row_index < data.number_of_rows();
+           ++row_index) {
+        y.push_back(data.value(row_index, y_column));
+      }
+      for (const std::size_t row_index : largest_triangle_three_buckets(
+               x, y, maximum_number_of_rows / YColumns.size())) {
+        kept.insert(row_index);
+      }
+    }
+    return kept;
+  }
+};
+
+}  // namespace CatanRanker
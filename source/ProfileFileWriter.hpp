@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Profiler.hpp"
+#include "TextFileWriter.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writer of the statistics of a profiler as a JSON file, so that
+/// profiles of different runs or releases can be compared.
+class ProfileFileWriter : public TextFileWriter {
+public:
+  ProfileFileWriter(const std::experimental::filesystem::path& path,
+                    const Profiler& profiler) noexcept
+    : TextFileWriter(path) {
+    line("{");
+    line("  \"phases\": [");
+    const std::map<Phase, Profiler::Statistics> statistics{
+        profiler.statistics()};
+    std::size_t counter{0};
+    for (const std::pair<const Phase, Profiler::Statistics>& phase :
+         statistics) {
+      ++counter;
+      line("    {\"name\": \"" + label(phase.first) + "\", \"wall_seconds\": "
+           + number(phase.second.wall_seconds()) + ", \"cpu_seconds\": "
+           + number(phase.second.cpu_seconds)
+           + ", \"peak_resident_set_size_kib\": "
+           + std::to_string(phase.second.peak_resident_set_size_kib)
+           + ", \"intervals\": "
+           + std::to_string(phase.second.number_of_intervals)
+           + allocations(phase.second.allocations) + "}"
+           + (counter < statistics.size() ? "," : ""));
+    }
+    line("  ],");
+    line("  \"total\": {\"wall_seconds\": "
+         + number(profiler.total_wall_seconds()) + ", \"cpu_seconds\": "
+         + number(Profiler::process_cpu_seconds())
+         + ", \"peak_resident_set_size_kib\": "
+         + std::to_string(Profiler::peak_resident_set_size_kib())
+         + allocations(Allocations::total()) + "},");
+    line("  \"counters\": {");
+    const std::vector<std::pair<std::string, double>> counters{
+        profiler.counters()};
+    for (std::size_t index = 0; index < counters.size(); ++index) {
+      line("    \""
+           + lowercase(replace_character(counters[index].first, ' ', '_'))
+           + "\": " + number(counters[index].second)
+           + (index + 1 < counters.size() ? "," : ""));
+    }
+    line("  }");
+    line("}");
+  }
+
+private:
+  /// \brief Allocation fields of a phase, or nothing if the program is
+  /// compiled without allocation tracking.
+  static std::string allocations(
+      const Allocations::Statistics& statistics) noexcept {
+    if (!Allocations::Available) {
+      return {};
+    }
+    return ", \"allocations\": " + std::to_string(statistics.allocations)
+           + ", \"allocated_bytes\": " + std::to_string(statistics.bytes)
+           + ", \"peak_live_bytes\": "
+           + std::to_string(statistics.peak_live_bytes);
+  }
+
+  static std::string number(const double value) noexcept {
+    std::ostringstream stream;
+    stream << std::setprecision(9) << value;
+    return stream.str();
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "Allocations.hpp"
+#include "FileWriter.hpp"
+#include "Table.hpp"
+
+namespace CatanRanker {
+
+/// \brief Phases of a run that are measured by the profiler.
+enum class Phase : int8_t {
+  Read,
+  Parse,
+  Sort,
+  Rate,
+  DataFiles,
+  GnuplotFiles,
+  MarkdownFiles,
+  GlobalPlots,
+  PlayerPlots,
+};
+
+template <>
+const std::map<Phase, std::string> labels<Phase>{
+    {Phase::Read,          "Read"          },
+    {Phase::Parse,         "Parse"         },
+    {Phase::Sort,          "Sort"          },
+    {Phase::Rate,          "Rate"          },
+    {Phase::DataFiles,     "Data Files"    },
+    {Phase::GnuplotFiles,  "Gnuplot Files" },
+    {Phase::MarkdownFiles, "Markdown Files"},
+    {Phase::GlobalPlots,   "Global Plots"  },
+    {Phase::PlayerPlots,   "Player Plots"  },
+};
+
+/// \brief Records the wall time, CPU time, and peak resident set size of each
+/// phase of a run, along with throughput counters. A phase can be measured
+/// over several intervals, possibly on several threads at the same time: its
+/// wall time spans from the start of its first interval to the end of its last
+/// interval, and its CPU time is the sum of the CPU time of the threads during
+/// its intervals. If the program is compiled with allocation tracking, the heap
+/// allocations made by a thread during an interval are also attributed to its
+/// phase. Nothing is recorded if the profiler is disabled.
+class Profiler {
+public:
+  /// \brief Statistics of a phase.
+  struct Statistics {
+    std::chrono::steady_clock::time_point begin;
+
+    std::chrono::steady_clock::time_point end;
+
+    double cpu_seconds{0.0};
+
+    int64_t peak_resident_set_size_kib{0};
+
+    int64_t number_of_intervals{0};
+
+    /// \brief Allocations made during the intervals of the phase. Always zero
+    /// if the program is compiled without allocation tracking.
+    Allocations::Statistics allocations;
+
+    double wall_seconds() const noexcept {
+      return std::chrono::duration<double>(end - begin).count();
+    }
+  };
+
+  /// \brief Measures an interval of a phase on the current thread from its
+  /// construction to its destruction.
+  class Interval {
+  public:
+    Interval(Profiler& profiler, const Phase phase) noexcept
+      : profiler_(profiler), phase_(phase),
+        scope_(profiler.enabled() ? allocation_scope(phase) : 0) {
+      if (profiler_.enabled()) {
+        begin_ = std::chrono::steady_clock::now();
+        begin_cpu_seconds_ = thread_cpu_seconds();
+      }
+    }
+
+    ~Interval() noexcept {
+      if (profiler_.enabled()) {
+        profiler_.record(phase_, begin_, std::chrono::steady_clock::now(),
+                         thread_cpu_seconds() - begin_cpu_seconds_);
+      }
+    }
+
+    Interval(const Interval&) = delete;
+
+    Interval& operator=(const Interval&) = delete;
+
+  private:
+    Profiler& profiler_;
+
+    Phase phase_;
+
+    std::chrono::steady_clock::time_point begin_;
+
+    double begin_cpu_seconds_{0.0};
+
+    Allocations::Scope scope_;
+  };
+
+  Profiler(const bool enabled = false) noexcept
+    : enabled_(enabled), begin_(std::chrono::steady_clock::now()),
+      begin_files_(file_counters().files.load()),
+      begin_bytes_(file_counters().bytes.load()) {}
+
+  Profiler(const Profiler&) = delete;
+
+  Profiler& operator=(const Profiler&) = delete;
+
+  constexpr bool enabled() const noexcept {
+    return enabled_;
+  }
+
+  void add_games(const uint64_t number) noexcept {
+    games_ += number;
+  }
+
+  void add_rating_updates(const uint64_t number) noexcept {
+    rating_updates_ += number;
+  }
+
+  void add_gnuplot_processes(const uint64_t number) noexcept {
+    gnuplot_processes_ += number;
+  }
+
+  /// \brief Statistics of every phase that was measured.
+  std::map<Phase, Statistics> statistics() const noexcept {
+    std::map<Phase, Statistics> statistics;
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      statistics = statistics_;
+    }
+    for (std::pair<const Phase, Statistics>& phase : statistics) {
+      phase.second.allocations =
+          Allocations::statistics(allocation_scope(phase.first));
+    }
+    return statistics;
+  }
+
+  /// \brief Wall time in seconds since the profiler was created.
+  double total_wall_seconds() const noexcept {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - begin_)
+        .count();
+  }
+
+  /// \brief Throughput counters, as pairs of names and values.
+  std::vector<std::pair<std::string, double>> counters() const noexcept {
+    const std::map<Phase, Statistics> phases{statistics()};
+    const std::map<Phase, Statistics>::const_iterator rate{
+        phases.find(Phase::Rate)};
+    const double rate_seconds{
+        rate != phases.cend() ? rate->second.wall_seconds() : 0.0};
+    return {
+        {"Games", static_cast<double>(games_)},
+        {"Games per Second", per_second(games_, rate_seconds)},
+        {"Rating Updates", static_cast<double>(rating_updates_)},
+        {"Rating Updates per Second",
+         per_second(rating_updates_, rate_seconds)},
+        {"Files Written",
+         static_cast<double>(file_counters().files.load() - begin_files_)},
+        {"Bytes Written",
+         static_cast<double>(file_counters().bytes.load() - begin_bytes_)},
+        {"Gnuplot Processes", static_cast<double>(gnuplot_processes_)},
+    };
+  }
+
+  /// \brief Print the statistics of every phase and the counters as tables.
+  std::string print() const noexcept {
+    Column phase{"Phase", Column::Alignment::Left};
+    Column wall{"Wall Time (s)", Column::Alignment::Right};
+    Column cpu{"CPU Time (s)", Column::Alignment::Right};
+    Column peak{"Peak RSS (MiB)", Column::Alignment::Right};
+    Column allocations{"Allocations", Column::Alignment::Right};
+    Column allocated{"Allocated (MiB)", Column::Alignment::Right};
+    Column peak_live{"Peak Live (MiB)", Column::Alignment::Right};
+    const auto add_allocations = [&](const Allocations::Statistics& data) {
+      allocations.add_row(static_cast<int64_t>(data.allocations));
+      allocated.add_row(real_number_to_string(data.bytes / 1048576.0, 3));
+      peak_live.add_row(
+          real_number_to_string(data.peak_live_bytes / 1048576.0, 3));
+    };
+    for (const std::pair<const Phase, Statistics>& statistics : statistics()) {
+      phase.add_row(label(statistics.first));
+      wall.add_row(real_number_to_string(statistics.second.wall_seconds(), 3));
+      cpu.add_row(real_number_to_string(statistics.second.cpu_seconds, 3));
+      peak.add_row(real_number_to_string(
+          statistics.second.peak_resident_set_size_kib / 1024.0, 3));
+      add_allocations(statistics.second.allocations);
+    }
+    phase.add_row("Total");
+    wall.add_row(real_number_to_string(total_wall_seconds(), 3));
+    cpu.add_row(real_number_to_string(process_cpu_seconds(), 3));
+    peak.add_row(
+        real_number_to_string(peak_resident_set_size_kib() / 1024.0, 3));
+    add_allocations(Allocations::total());
+    Column counter{"Counter", Column::Alignment::Left};
+    Column value{"Value", Column::Alignment::Right};
+    for (const std::pair<std::string, double>& datum : counters()) {
+      counter.add_row(datum.first);
+      if (datum.second == std::floor(datum.second)) {
+        value.add_row(static_cast<int64_t>(datum.second));
+      } else {
+        value.add_row(real_number_to_string(datum.second, 6));
+      }
+    }
+    std::vector<Column> phase_columns{phase, wall, cpu, peak};
+    if (Allocations::Available) {
+      phase_columns.push_back(allocations);
+      phase_columns.push_back(allocated);
+      phase_columns.push_back(peak_live);
+    }
+    const Table phases{phase_columns};
+    const Table throughput{
+        {counter, value}
+    };
+    return "Profile:\n" + phases.print_as_markdown() + "\n\n"
+           + throughput.print_as_markdown();
+  }
+
+  /// \brief CPU time in seconds of the whole process so far.
+  static double process_cpu_seconds() noexcept {
+    return cpu_seconds(CLOCK_PROCESS_CPUTIME_ID);
+  }
+
+  /// \brief Peak resident set size in KiB of the process so far.
+  static int64_t peak_resident_set_size_kib() noexcept {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      return static_cast<int64_t>(usage.ru_maxrss);
+    }
+    return 0;
+  }
+
+private:
+  bool enabled_{false};
+
+  std::chrono::steady_clock::time_point begin_;
+
+  uint64_t begin_files_{0};
+
+  uint64_t begin_bytes_{0};
+
+  std::atomic<uint64_t> games_{0};
+
+  std::atomic<uint64_t> rating_updates_{0};
+
+  std::atomic<uint64_t> gnuplot_processes_{0};
+
+  mutable std::mutex mutex_;
+
+  std::map<Phase, Statistics> statistics_;
+
+  static double cpu_seconds(const clockid_t clock) noexcept {
+    struct timespec time;
+    if (clock_gettime(clock, &time) == 0) {
+      return static_cast<double>(time.tv_sec) + time.tv_nsec * 1.0e-9;
+    }
+    return 0.0;
+  }
+
+  /// \brief Allocation scope of a phase. Scope 0 is reserved for allocations
+  /// made outside of any phase.
+  static std::size_t allocation_scope(const Phase phase) noexcept {
+    return static_cast<std::size_t>(phase) + 1;
+  }
+
+  static double thread_cpu_seconds() noexcept {
+    return cpu_seconds(CLOCK_THREAD_CPUTIME_ID);
+  }
+
+  static double per_second(const uint64_t number, const double seconds) {
+    return seconds > 0.0 ? static_cast<double>(number) / seconds : 0.0;
+  }
+
+  void record(const Phase phase,
+              const std::chrono::steady_clock::time_point begin,
+              const std::chrono::steady_clock::time_point end,
+              const double cpu_seconds) noexcept {
+    const int64_t peak{peak_resident_set_size_kib()};
+    const std::lock_guard<std::mutex> lock{mutex_};
+    std::map<Phase, Statistics>::iterator found{statistics_.find(phase)};
+    if (found == statistics_.end()) {
+      Statistics statistics;
+      statistics.begin = begin;
+      statistics.end = end;
+      found = statistics_.insert({phase, statistics}).first;
+    }
+    Statistics& statistics{found->second};
+    statistics.begin = std::min(statistics.begin, begin);
+    statistics.end = std::max(statistics.end, end);
+    statistics.cpu_seconds += cpu_seconds;
+    statistics.peak_resident_set_size_kib =
+        std::max(statistics.peak_resident_set_size_kib, peak);
+    ++statistics.number_of_intervals;
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,722 @@
+#pragma once
+
+#include "PeriodStatistics.hpp"
+#include "Standings.hpp"
+
+namespace CatanRanker {
+
+/// \brief Answers queries about the games and players of a run that are kept in
+/// memory, such as the current ratings or the history of a player, and records
+/// new games. Each answer is a single-line JSON document. Queries are not
+/// thread-safe and must be made from a single thread.
+class Queries {
+public:
+  /// \brief Games that are added are also appended to the games file, if any,
+  /// so that they are not lost when the program exits.
+  Queries(Games& games, Players& players, Context& context,
+          const std::experimental::filesystem::path& games_file) noexcept
+    : games_(games), players_(players), context_(context),
+      games_file_(games_file) {}
+
+  /// \brief Answer a request made of a command followed by its arguments.
+  /// Errors are answered with a JSON document containing an error message. The
+  /// commands are:
+  /// - "ratings [<category>]": current rating of each player.
+  /// - "history <player> [<category>]": history of a player.
+  /// - "leaderboard [<category>]": summary of each player, by rating.
+  /// - "games [<from> [<to>]]": results of the games between two dates.
+  /// - "rating <player> <moment> [<category>]": statistics of a player at a
+  ///   moment.
+  /// - "ratings-at <moments> [<category>]": rating of each player at each of
+  ///   a comma-separated list of moments, or at the end of every month if the
+  ///   moments are "monthly".
+  /// - "rank <player> <moment> [<category>]": rank of a player at a moment.
+  /// - "top <number> <moment> [<category>]": highest ranked players at a
+  ///   moment.
+  /// - "ranks <player> [<category>]": rank of a player after each of the
+  ///   player's games.
+  /// - "stats <player> <from> <to> [<category>]": statistics of a player over
+  ///   the games from one moment to another, or over each month if the
+  ///   moments are replaced by "monthly".
+  /// - "add <game>": record a game, such as "add 2024-05-01 : 10 : Alice 10 ,
+  ///   Bob 8 , Claire 7".
+  /// The category is "all", "3-4", "5-6", or "7-8", and defaults to "all". A
+  /// moment is a date, such as "2024-05-01", or a game number, such as "250".
+  std::string answer(const std::string& request) noexcept {
+    try {
+      const std::string trimmed{trim(request)};
+      const std::size_t space{trimmed.find(' ')};
+      const std::string command{trimmed.substr(0, space)};
+      const std::string argument{
+          space != std::string::npos ? trim(trimmed.substr(space + 1)) :
+                                       std::string{}};
+      if (command == "ratings") {
+        return ratings(game_category(argument));
+      } else if (command == "history") {
+        const std::size_t separator{argument.find(' ')};
+        return history(
+            PlayerName{argument.substr(0, separator)},
+            game_category(separator != std::string::npos ?
+                              trim(argument.substr(separator + 1)) :
+                              std::string{}));
+      } else if (command == "leaderboard") {
+        return leaderboard(game_category(argument));
+      } else if (command == "games") {
+        const std::vector<std::string> dates{split_by_whitespace(argument)};
+        return games(
+            dates.size() > 0 ? std::optional<Date>{Date{dates[0]}} :
+                               std::optional<Date>{},
+            dates.size() > 1 ? std::optional<Date>{Date{dates[1]}} :
+                               std::optional<Date>{});
+      } else if (command == "rating") {
+        const std::vector<std::string> words{split_by_whitespace(argument)};
+        if (words.size() < 2 || words.size() > 3) {
+          error("Expected a player and a moment, such as 'rating Alice "
+                "2024-05-01'.");
+        }
+        return rating(PlayerName{words[0]}, Moment::parse(words[1]),
+                      game_category(words.size() > 2 ? words[2] :
+                                                       std::string{}));
+      } else if (command == "ratings-at") {
+        const std::vector<std::string> words{split_by_whitespace(argument)};
+        if (words.empty() || words.size() > 2) {
+          error("Expected one or more moments, such as 'ratings-at "
+                "2024-01-31,2024-02-29'.");
+        }
+        return ratings(
+            moments(words[0]),
+            game_category(words.size() > 1 ? words[1] : std::string{}));
+      } else if (command == "rank") {
+        const std::vector<std::string> words{split_by_whitespace(argument)};
+        if (words.size() < 2 || words.size() > 3) {
+          error("Expected a player and a moment, such as 'rank Alice "
+                "2024-05-01'.");
+        }
+        return rank(PlayerName{words[0]}, Moment::parse(words[1]),
+                    game_category(words.size() > 2 ? words[2] :
+                                                     std::string{}));
+      } else if (command == "top") {
+        const std::vector<std::string> words{split_by_whitespace(argument)};
+        const std::optional<int64_t> number{
+            words.empty() ? std::optional<int64_t>{} :
+                            string_to_integer_number(words[0])};
+        if (words.size() < 2 || words.size() > 3 || !number.has_value()
+            || number.value() < 1) {
+          error("Expected a number of players and a moment, such as 'top 10 "
+                "2024-05-01'.");
+        }
+        return top(static_cast<std::size_t>(number.value()),
+                   Moment::parse(words[1]),
+                   game_category(words.size() > 2 ? words[2] :
+                                                    std::string{}));
+      } else if (command == "ranks") {
+        const std::vector<std::string> words{split_by_whitespace(argument)};
+        if (words.empty() || words.size() > 2) {
+          error("Expected a player, such as 'ranks Alice'.");
+        }
+        return ranks(PlayerName{words[0]},
+                     game_category(words.size() > 1 ? words[1] :
+                                                      std::string{}));
+      } else if (command == "stats") {
+        const std::vector<std::string> words{split_by_whitespace(argument)};
+        if (words.size() >= 2 && words[1] == "monthly" && words.size() <= 3) {
+          return monthly_statistics(
+              PlayerName{words[0]},
+              game_category(words.size() > 2 ? words[2] : std::string{}));
+        }
+        if (words.size() < 3 || words.size() > 4) {
+          error("Expected a player and two moments, such as 'stats Alice "
+                "2024-01-01 2024-03-31', or a player and 'monthly'.");
+        }
+        const Moment from{Moment::parse(words[1])};
+        const Moment to{Moment::parse(words[2])};
+        if (from.begins_after(to)) {
+          error("The period from " + from.print() + " to " + to.print()
+                + " begins after it ends.");
+        }
+        return statistics(
+            PlayerName{words[0]}, from, to,
+            game_category(words.size() > 3 ? words[3] : std::string{}));
+      } else if (command == "add") {
+        return add(argument);
+      } else {
+        error("Unknown command: '" + command
+              + "'. Expected ratings, history, leaderboard, games, rating, "
+                "ratings-at, rank, top, ranks, stats, or add.");
+      }
+    } catch (const std::exception& exception) {
+      return failure(exception.what());
+    }
+    return {};
+  }
+
+  /// \brief Current rating and number of games of each player who has games
+  /// in a game category, from the highest to the lowest rating.
+  std::string ratings(const GameCategory game_category) const noexcept {
+    std::string text{"{\"category\": "};
+    append_string(text, label(game_category));
+    text += ", \"players\": [";
+    std::size_t counter{0};
+    for (const Player* player : ranking(game_category)) {
+      const PlayerProperties& latest{
+          player->latest_properties(game_category).value()};
+      text += counter > 0 ? ", {\"name\": " : "{\"name\": ";
+      append_string(text, player->name().value());
+      text += ", \"games\": ";
+      append_integer(text, latest.player_game_category_game_number());
+      text += ", \"rating\": ";
+      append_number(text, latest.elo_rating().value());
+      text += '}';
+      ++counter;
+    }
+    return text + "]}";
+  }
+
+  /// \brief Properties of a player after each of the player's games in a game
+  /// category.
+  std::string history(const PlayerName& player_name,
+                      const GameCategory game_category) const {
+    const Player& player{players_.find(player_name)};
+    std::string text{"{\"name\": "};
+    append_string(text, player.name().value());
+    text += ", \"category\": ";
+    append_string(text, label(game_category));
+    text += ", \"games\": [";
+    std::size_t counter{0};
+    for (const PlayerProperties& properties : player[game_category]) {
+      text += counter > 0 ? ", {\"game\": " : "{\"game\": ";
+      append_integer(text, properties.game_number());
+      text += ", \"date\": ";
+      append_string(text, properties.date().print());
+      text += ", ";
+      append_properties(text, properties);
+      text += '}';
+      ++counter;
+    }
+    return text + "]}";
+  }
+
+  /// \brief Whether a player has played any game.
+  bool contains(const PlayerName& player_name) const noexcept {
+    return players_.contains(player_name);
+  }
+
+  /// \brief Summary of each player who has games in a game category, from the
+  /// highest to the lowest rating, up to a number of players.
+  std::string leaderboard(
+      const GameCategory game_category,
+      const std::size_t number = std::numeric_limits<std::size_t>::max()) const
+      noexcept {
+    std::string text{"{\"category\": "};
+    append_string(text, label(game_category));
+    text += ", \"players\": [";
+    int64_t rank{0};
+    for (const Player* player : ranking(game_category)) {
+      if (static_cast<std::size_t>(rank) >= number) {
+        break;
+      }
+      ++rank;
+      text += rank > 1 ? ", {\"rank\": " : "{\"rank\": ";
+      append_integer(text, rank);
+      text += ", \"name\": ";
+      append_string(text, player->name().value());
+      text += ", ";
+      append_properties(
+          text, player->latest_properties(game_category).value());
+      text += '}';
+    }
+    return text + "]}";
+  }
+
+  /// \brief Results of the games played between two dates, inclusive. Either
+  /// date can be omitted, in which case the range is open on that side.
+  std::string games(const std::optional<Date>& from,
+                    const std::optional<Date>& to) const noexcept {
+    const Games::const_iterator begin{
+        from.has_value() ?
+            std::lower_bound(games_.cbegin(), games_.cend(), from.value(),
+                             [](const Game& game, const Date& date) {
+                               return game.date() < date;
+                             }) :
+            games_.cbegin()};
+    const Games::const_iterator end{
+        to.has_value() ?
+            std::upper_bound(games_.cbegin(), games_.cend(), to.value(),
+                             [](const Date& date, const Game& game) {
+                               return date < game.date();
+                             }) :
+            games_.cend()};
+    std::string text{"{\"games\": ["};
+    for (Games::const_iterator game = begin; game < end; ++game) {
+      if (game != begin) {
+        text += ", ";
+      }
+      append_game(text, *game);
+    }
+    return text + "]}";
+  }
+
+  /// \brief Statistics of a player in a game category at a moment, after the
+  /// player's last game at or before that moment.
+  std::string rating(const PlayerName& player_name, const Moment& moment,
+                     const GameCategory game_category) const {
+    const Player& player{players_.find(player_name)};
+    std::string text{"{\"name\": "};
+    append_string(text, player.name().value());
+    text += ", \"category\": ";
+    append_string(text, label(game_category));
+    text += ", \"at\": ";
+    append_string(text, moment.print());
+    const PlayerProperties* properties{
+        player.properties(game_category, moment)};
+    if (properties != nullptr) {
+      text += ", \"game\": ";
+      append_integer(text, properties->game_number());
+      text += ", \"date\": ";
+      append_string(text, properties->date().print());
+      text += ", ";
+      append_properties(text, *properties);
+    } else {
+      text += ", \"games\": 0";
+    }
+    return text + "}";
+  }
+
+  /// \brief Rating and number of games of each player who had games in a game
+  /// category at each of several moments, from the highest to the lowest
+  /// rating at that moment. Each player's history is binary searched, so each
+  /// moment takes a time proportional to the number of players times the
+  /// logarithm of the number of games.
+  std::string ratings(const std::vector<Moment>& moments,
+                      const GameCategory game_category) const noexcept {
+    std::string text{"{\"category\": "};
+    append_string(text, label(game_category));
+    text += ", \"moments\": [";
+    std::vector<std::pair<const Player*, const PlayerProperties*>> ranking;
+    for (const Moment& moment : moments) {
+      ranking.clear();
+      for (const Player& player : players_) {
+        const PlayerProperties* properties{
+            player.properties(game_category, moment)};
+        if (properties != nullptr) {
+          ranking.emplace_back(&player, properties);
+        }
+      }
+      std::stable_sort(
+          ranking.begin(), ranking.end(),
+          [](const std::pair<const Player*, const PlayerProperties*>& entry_1,
+             const std::pair<const Player*, const PlayerProperties*>& entry_2) {
+            return entry_1.second->elo_rating().value()
+                   > entry_2.second->elo_rating().value();
+          });
+      text += &moment != &moments.front() ? ", {\"at\": " : "{\"at\": ";
+      append_string(text, moment.print());
+      text += ", \"players\": [";
+      std::size_t counter{0};
+      for (const std::pair<const Player*, const PlayerProperties*>& entry :
+           ranking) {
+        text += counter > 0 ? ", {\"name\": " : "{\"name\": ";
+        append_string(text, entry.first->name().value());
+        text += ", \"games\": ";
+        append_integer(text, entry.second->player_game_category_game_number());
+        text += ", \"rating\": ";
+        append_number(text, entry.second->elo_rating().value());
+        text += '}';
+        ++counter;
+      }
+      text += "]}";
+    }
+    return text + "]}";
+  }
+
+  /// \brief Moments given as a comma-separated list of dates and game numbers,
+  /// or the end of every month from the first game to the last game if the
+  /// text is "monthly".
+  std::vector<Moment> moments(const std::string& text) const {
+    if (text == "monthly") {
+      if (games_.size() == 0) {
+        return {};
+      }
+      return Moment::month_ends(
+          games_.cbegin()->date(), games_.crbegin()->date());
+    }
+    std::vector<Moment> moments;
+    for (const std::string& moment : split(text, ',')) {
+      moments.push_back(Moment::parse(trim(moment)));
+    }
+    return moments;
+  }
+
+  /// \brief Rank of a player in a game category at a moment, among the players
+  /// who had games in that game category.
+  std::string rank(const PlayerName& player_name, const Moment& moment,
+                   const GameCategory game_category) {
+    const Player& player{players_.find(player_name)};
+    const Standings& standings{this->standings(game_category)};
+    const std::size_t version{standings.version(moment)};
+    std::string text{"{\"name\": "};
+    append_string(text, player.name().value());
+    text += ", \"category\": ";
+    append_string(text, label(game_category));
+    text += ", \"at\": ";
+    append_string(text, moment.print());
+    const std::optional<std::size_t> rank{standings.rank(player, version)};
+    if (rank.has_value()) {
+      text += ", \"rank\": ";
+      append_integer(text, static_cast<int64_t>(rank.value()));
+      text += ", \"players\": ";
+      append_integer(
+          text, static_cast<int64_t>(standings.number_of_players(version)));
+      text += ", \"rating\": ";
+      append_number(
+          text,
+          standings.properties(player, version)->elo_rating().value());
+    } else {
+      text += ", \"games\": 0";
+    }
+    return text + "}";
+  }
+
+  /// \brief Highest ranked players in a game category at a moment.
+  std::string top(const std::size_t number, const Moment& moment,
+                  const GameCategory game_category) {
+    const Standings& standings{this->standings(game_category)};
+    const std::size_t version{standings.version(moment)};
+    std::string text{"{\"category\": "};
+    append_string(text, label(game_category));
+    text += ", \"at\": ";
+    append_string(text, moment.print());
+    text += ", \"players\": [";
+    int64_t rank{0};
+    for (const Player* player : standings.top(version, number)) {
+      const PlayerProperties& properties{
+          *standings.properties(*player, version)};
+      ++rank;
+      text += rank > 1 ? ", {\"rank\": " : "{\"rank\": ";
+      append_integer(text, rank);
+      text += ", \"name\": ";
+      append_string(text, player->name().value());
+      text += ", \"games\": ";
+      append_integer(text, properties.player_game_category_game_number());
+      text += ", \"rating\": ";
+      append_number(text, properties.elo_rating().value());
+      text += '}';
+    }
+    return text + "]}";
+  }
+
+  /// \brief Rank of a player in a game category after each of the player's
+  /// games in that game category, along with the number of ranked players.
+  std::string ranks(const PlayerName& player_name,
+                    const GameCategory game_category) {
+    const Player& player{players_.find(player_name)};
+    const Standings& standings{this->standings(game_category)};
+    std::string text{"{\"name\": "};
+    append_string(text, player.name().value());
+    text += ", \"category\": ";
+    append_string(text, label(game_category));
+    text += ", \"ranks\": [";
+    std::size_t counter{0};
+    for (const PlayerProperties& properties : player[game_category]) {
+      const std::size_t version{static_cast<std::size_t>(
+          properties.game_category_game_number())};
+      text += counter > 0 ? ", {\"game\": " : "{\"game\": ";
+      append_integer(text, properties.game_number());
+      text += ", \"date\": ";
+      append_string(text, properties.date().print());
+      text += ", \"rank\": ";
+      append_integer(
+          text, static_cast<int64_t>(standings.rank(player, version).value()));
+      text += ", \"players\": ";
+      append_integer(
+          text, static_cast<int64_t>(standings.number_of_players(version)));
+      text += '}';
+      ++counter;
+    }
+    return text + "]}";
+  }
+
+  /// \brief Statistics of a player in a game category over the games from the
+  /// beginning of one moment to the end of another, inclusive.
+  std::string statistics(const PlayerName& player_name, const Moment& from,
+                         const Moment& to,
+                         const GameCategory game_category) const {
+    const Player& player{players_.find(player_name)};
+    std::string text{"{\"name\": "};
+    append_string(text, player.name().value());
+    text += ", \"category\": ";
+    append_string(text, label(game_category));
+    text += ", \"from\": ";
+    append_string(text, from.print());
+    text += ", \"to\": ";
+    append_string(text, to.print());
+    text += ", ";
+    append_statistics(text, statistics(player, from, to, game_category));
+    return text + "}";
+  }
+
+  /// \brief Statistics of a player in a game category over each month from
+  /// the month of the player's first game to the month of the player's last
+  /// game in that game category.
+  std::string monthly_statistics(const PlayerName& player_name,
+                                 const GameCategory game_category) const {
+    const Player& player{players_.find(player_name)};
+    std::string text{"{\"name\": "};
+    append_string(text, player.name().value());
+    text += ", \"category\": ";
+    append_string(text, label(game_category));
+    text += ", \"months\": [";
+    const std::vector<PlayerProperties>& history{player[game_category]};
+    if (!history.empty()) {
+      std::size_t counter{0};
+      for (Date last_day = history.front().date().end_of_month();
+           last_day <= history.back().date().end_of_month();
+           last_day = last_day.end_of_next_month()) {
+        const Date first_day{static_cast<int16_t>(last_day.year()),
+                             last_day.month_number(), 1};
+        text += counter > 0 ? ", {\"month\": " : "{\"month\": ";
+        append_string(text, last_day.print().substr(0, 7));
+        text += ", ";
+        append_statistics(
+            text, statistics(player, first_day, last_day, game_category));
+        text += '}';
+        ++counter;
+      }
+    }
+    return text + "]}";
+  }
+
+  /// \brief Record a game given in the format of the games file, and answer
+  /// with the updated ratings of its participants.
+  std::string add(const std::string& line) {
+    Game game{line, &context_.arena};
+    if (!games_file_.empty()) {
+      append_line(games_file_, line);
+    }
+    const std::size_t index{games_.add(std::move(game))};
+    players_.add(games_, index, context_);
+    standings_.clear();
+    context_.profiler.add_games(1);
+    const Game& added{games_[index]};
+    std::string text{"{\"game\": "};
+    append_integer(text, added.number());
+    text += ", \"date\": ";
+    append_string(text, added.date().print());
+    text += ", \"players\": [";
+    std::size_t counter{0};
+    for (const PlayerName& player_name : added) {
+      const Player& player{players_.find(player_name)};
+      text += counter > 0 ? ", {\"name\": " : "{\"name\": ";
+      append_string(text, player_name.value());
+      text += ", \"rating\": ";
+      append_number(
+          text, player.elo_rating(GameCategory::AnyNumberOfPlayers).value());
+      text += ", \"category_rating\": ";
+      append_number(text, player.elo_rating(added.category()).value());
+      text += '}';
+      ++counter;
+    }
+    return text + "]}";
+  }
+
+  /// \brief Game category with a given short name: "all", "3-4", "5-6", or
+  /// "7-8". An empty name is all games.
+  static GameCategory game_category(const std::string& name) {
+    if (name.empty() || name == "all") {
+      return GameCategory::AnyNumberOfPlayers;
+    } else if (name == "3-4") {
+      return GameCategory::ThreeToFourPlayers;
+    } else if (name == "5-6") {
+      return GameCategory::FiveToSixPlayers;
+    } else if (name == "7-8") {
+      return GameCategory::SevenToEightPlayers;
+    }
+    error("Unknown game category: '" + name
+          + "'. Expected all, 3-4, 5-6, or 7-8.");
+  }
+
+  /// \brief JSON document containing an error message.
+  static std::string failure(const std::string& message) noexcept {
+    std::string text{"{\"error\": "};
+    append_string(text, message);
+    return text + "}";
+  }
+
+private:
+  Games& games_;
+
+  Players& players_;
+
+  Context& context_;
+
+  std::experimental::filesystem::path games_file_;
+
+  /// \brief Ranking index of each game category, built when it is first
+  /// queried and discarded when a game is added.
+  std::map<GameCategory, Standings> standings_;
+
+  const Standings& standings(const GameCategory game_category) {
+    std::map<GameCategory, Standings>::const_iterator found{
+        standings_.find(game_category)};
+    if (found == standings_.cend()) {
+      found = standings_
+                  .emplace(std::piecewise_construct,
+                           std::forward_as_tuple(game_category),
+                           std::forward_as_tuple(
+                               games_, players_, game_category))
+                  .first;
+    }
+    return found->second;
+  }
+
+  /// \brief Players who have games in a game category, from the highest to the
+  /// lowest current rating.
+  std::vector<const Player*> ranking(
+      const GameCategory game_category) const noexcept {
+    std::vector<const Player*> ranking;
+    for (const Player& player : players_) {
+      if (player.number_of_games(game_category) > 0) {
+        ranking.push_back(&player);
+      }
+    }
+    std::stable_sort(
+        ranking.begin(), ranking.end(),
+        [game_category](const Player* player_1, const Player* player_2) {
+          return player_1->elo_rating(game_category).value()
+                 > player_2->elo_rating(game_category).value();
+        });
+    return ranking;
+  }
+
+  /// \brief Append the date, winning points, and results by place of a game.
+  static void append_game(std::string& text, const Game& game) noexcept {
+    std::vector<std::pair<Place, const PlayerName*>> places_and_player_names;
+    for (const PlayerName& player_name : game) {
+      places_and_player_names.emplace_back(
+          game.place(player_name).value(), &player_name);
+    }
+    std::stable_sort(places_and_player_names.begin(),
+                     places_and_player_names.end(),
+                     [](const std::pair<Place, const PlayerName*>& element_1,
+                        const std::pair<Place, const PlayerName*>& element_2) {
+                       return element_1.first.value()
+                              < element_2.first.value();
+                     });
+    text += "{\"game\": ";
+    append_integer(text, game.number());
+    text += ", \"date\": ";
+    append_string(text, game.date().print());
+    text += ", \"winning_points\": ";
+    append_integer(text, game.winning_points().value());
+    text += ", \"results\": [";
+    std::size_t counter{0};
+    for (const std::pair<Place, const PlayerName*>& place_and_player_name :
+         places_and_player_names) {
+      text += counter > 0 ? ", {\"name\": " : "{\"name\": ";
+      append_string(text, place_and_player_name.second->value());
+      text += ", \"points\": ";
+      append_integer(
+          text, game.points(*place_and_player_name.second).value().value());
+      text += ", \"place\": ";
+      append_integer(text, place_and_player_name.first.value());
+      text += '}';
+      ++counter;
+    }
+    text += "]}";
+  }
+
+  static PeriodStatistics statistics(
+      const Player& player, const Moment& from, const Moment& to,
+      const GameCategory game_category) noexcept {
+    const PlayerProperties* const before{
+        player.properties_before(game_category, from)};
+    const PlayerProperties* const last{player.properties(game_category, to)};
+    // A date and a game number cannot be compared without the games, so a
+    // period that begins after it ends is only detected here, and is empty.
+    if (before != nullptr && last != nullptr
+        && before->player_game_category_game_number()
+               > last->player_game_category_game_number()) {
+      return {last, last};
+    }
+    return {before, last};
+  }
+
+  /// \brief Append the fields of the statistics of a player over a period.
+  static void append_statistics(
+      std::string& text, const PeriodStatistics& statistics) noexcept {
+    text += "\"games\": ";
+    append_integer(text, statistics.number_of_games());
+    if (statistics.number_of_games() > 0) {
+      text += ", \"average_points\": ";
+      append_number(text, statistics.average_points_per_game());
+      text += ", \"first_place\": ";
+      append_number(text, statistics.place_percentage({1}).value());
+      text += ", \"second_place\": ";
+      append_number(text, statistics.place_percentage({2}).value());
+      text += ", \"third_place\": ";
+      append_number(text, statistics.place_percentage({3}).value());
+      text += ", \"average_rating\": ";
+      append_number(text, statistics.average_elo_rating().value());
+      text += ", \"rating_change\": ";
+      append_number(text, statistics.elo_rating_change());
+    }
+  }
+
+  /// \brief Append the fields of the statistics of a player in a game
+  /// category after a game.
+  static void append_properties(
+      std::string& text, const PlayerProperties& properties) noexcept {
+    text += "\"games\": ";
+    append_integer(text, properties.player_game_category_game_number());
+    text += ", \"rating\": ";
+    append_number(text, properties.elo_rating().value());
+    text += ", \"average_rating\": ";
+    append_number(text, properties.average_elo_rating().value());
+    text += ", \"average_points\": ";
+    append_number(text, properties.average_points_per_game());
+    text += ", \"first_place\": ";
+    append_number(text, properties.place_percentage({1}).value());
+    text += ", \"second_place\": ";
+    append_number(text, properties.place_percentage({2}).value());
+    text += ", \"third_place\": ";
+    append_number(text, properties.place_percentage({3}).value());
+  }
+
+  /// \brief Append a quoted JSON string, with the characters that cannot
+  /// appear as-is escaped.
+  static void append_string(
+      std::string& text, const std::string& value) noexcept {
+    text += '"';
+    for (const char character : value) {
+      if (character == '"' || character == '\\') {
+        text += '\\';
+        text += character;
+      } else if (static_cast<unsigned char>(character) < 0x20) {
+        text += ' ';
+      } else {
+        text += character;
+      }
+    }
+    text += '"';
+  }
+
+  static void append_integer(std::string& text, const int64_t value) noexcept {
+    char characters[24];
+    const std::to_chars_result result{std::to_chars(
+        characters, characters + sizeof(characters), value)};
+    text.append(characters, result.ptr);
+  }
+
+  /// \brief Append a number with 9 significant digits. Formatted with
+  /// std::to_chars rather than a string stream because large answers contain
+  /// thousands of numbers.
+  static void append_number(std::string& text, const double value) noexcept {
+    char characters[32];
+    const std::to_chars_result result{
+        std::to_chars(characters, characters + sizeof(characters), value,
+                      std::chars_format::general, 9)};
+    text.append(characters, result.ptr);
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Players.hpp"
+
+namespace CatanRanker {
+
+/// \brief Cache of the strings that appear in several leaderboard files, such
+/// as the results of a game, which appear in the global history and in the
+/// history of each participant, and the summary of a player in a game category,
+/// which appears in the global summary and in the player's own summary. Each
+/// string is formatted once and then reused by every file writer.
+class RenderCache {
+public:
+  /// \brief Summary of a player in a game category, formatted for the summary
+  /// tables.
+  struct SummaryRow {
+    std::string number_of_games;
+
+    std::string elo_rating;
+
+    std::string average_elo_rating;
+
+    std::string average_points_per_game;
+
+    std::string first_place;
+
+    std::string second_place;
+
+    std::string third_place;
+
+    std::string recent_average_points_per_game;
+
+    std::string recent_first_place;
+
+    std::string recent_elo_rating_change;
+
+    std::string exponential_average_points_per_game;
+  };
+
+  /// \brief Allocate the cache without rendering anything. The rendering
+  /// functions can then be called concurrently for different games and
+  /// players.
+  RenderCache(const Games& games, const Players& players) noexcept
+    : RenderCache(players) {
+    game_results_.resize(games.size());
+  }
+
+  /// \brief Allocate the cache of the summaries of the players only, for
+  /// writing files that do not list games.
+  RenderCache(const Players& players) noexcept {
+    for (const Player& player : players) {
+      std::map<GameCategory, std::optional<SummaryRow>>& summary_rows{
+          summary_rows_[player.name()]};
+      for (const GameCategory game_category : GameCategories) {
+        summary_rows.insert({game_category, {}});
+      }
+    }
+  }
+
+  /// \brief Render the results of the games whose indices are in a range.
+  void render_game_results(
+      const Games& games, const std::size_t begin,
+      const std::size_t end) noexcept {
+    for (std::size_t index = begin; index < end && index < games.size();
+         ++index) {
+      game_results_[index] = games[index].print_results();
+    }
+  }
+
+  /// \brief Render the summary of a player in every game category.
+  void render_summary_rows(const Player& player) noexcept {
+    std::map<GameCategory, std::optional<SummaryRow>>& summary_rows{
+        summary_rows_.find(player.name())->second};
+    for (const GameCategory game_category : GameCategories) {
+      const std::optional<PlayerProperties>& latest{
+          player.latest_properties(game_category)};
+      if (latest.has_value()) {
+        summary_rows[game_category] = summary_row(latest.value());
+      }
+    }
+  }
+
+  const std::string& game_results(const std::size_t index) const noexcept {
+    return game_results_[index];
+  }
+
+  /// \brief Summary of a player in a game category. Empty if the player has no
+  /// games in this game category.
+  const std::optional<SummaryRow>& summary_row(
+      const PlayerName& player_name,
+      const GameCategory game_category) const noexcept {
+    return summary_rows_.find(player_name)->second.find(game_category)->second;
+  }
+
+private:
+  std::vector<std::string> game_results_;
+
+  std::map<PlayerName, std::map<GameCategory, std::optional<SummaryRow>>,
+           PlayerName::sort>
+      summary_rows_;
+
+  SummaryRow summary_row(const PlayerProperties& latest) const noexcept {
+    SummaryRow row;
+    row.number_of_games =
+        std::to_string(latest.player_game_category_game_number());
+    row.elo_rating = latest.elo_rating().print();
+    row.average_elo_rating = latest.average_elo_rating().print();
+    row.average_points_per_game =
+        real_number_to_string(latest.average_points_per_game(), 3);
+    row.first_place = place(latest, {1});
+    row.second_place = place(latest, {2});
+    row.third_place = place(latest, {3});
+    row.recent_average_points_per_game =
+        real_number_to_string(latest.recent_average_points_per_game(), 3);
+    row.recent_first_place = latest.recent_first_place_percentage().print(0);
+    row.recent_elo_rating_change =
+        (latest.recent_elo_rating_change() >= 0.5 ? "+" : "")
+        + EloRating{latest.recent_elo_rating_change()}.print();
+    row.exponential_average_points_per_game =
+        real_number_to_string(latest.exponential_average_points_per_game(), 3);
+    return row;
+  }
+
+  /// \brief Percentage and number of Nth place finishes, such as "42% (5)".
+  std::string place(
+      const PlayerProperties& latest, const Place& place) const noexcept {
+    return latest.place_percentage(place).print(0) + " ("
+           + std::to_string(latest.place_count(place)) + ")";
+  }
+};
+
+}  // namespace CatanRanker
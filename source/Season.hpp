@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Players.hpp"
+
+namespace CatanRanker {
+
+/// \brief Games of a season and the players computed from them alone, so every
+/// player starts the season with the starting Elo rating.
+class Season {
+public:
+  /// \brief Compute the season of the games whose indices are in a range of
+  /// the games. The player histories are allocated from the season's own
+  /// arena, so seasons can be computed concurrently. If a streaming directory
+  /// is given, the player histories are streamed to the data files of the
+  /// season's leaderboard in that directory.
+  Season(
+      const std::string& name, const Games& games, const std::size_t begin,
+      const std::size_t end, Context& context,
+      const std::experimental::filesystem::path& streaming_directory) noexcept
+    : name_(name), games_(games, begin, end),
+      players_(games_, context, &arena_, streaming_directory) {}
+
+  Season(const Season&) = delete;
+
+  Season& operator=(const Season&) = delete;
+
+  const std::string& name() const noexcept {
+    return name_;
+  }
+
+  const Games& games() const noexcept {
+    return games_;
+  }
+
+  const Players& players() const noexcept {
+    return players_;
+  }
+
+private:
+  std::string name_;
+
+  std::pmr::monotonic_buffer_resource arena_;
+
+  Games games_;
+
+  Players players_;
+};
+
+}  // namespace CatanRanker
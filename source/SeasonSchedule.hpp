@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Date.hpp"
+
+namespace CatanRanker {
+
+/// \brief Rule that assigns each date to a season. Seasons are either periods
+/// of the calendar, such as years or quarters, or start on given dates.
+class SeasonSchedule {
+public:
+  /// \brief Constructor from a specification: "yearly", "quarterly", or a
+  /// comma-separated list of YYYY-MM-DD dates in increasing order on which
+  /// seasons start, such as "2020-01-01,2020-07-01". Dates before the first
+  /// start date belong to no season.
+  SeasonSchedule(const std::string& specification) {
+    if (specification == Yearly) {
+      period_ = Period::Year;
+    } else if (specification == Quarterly) {
+      period_ = Period::Quarter;
+    } else {
+      for (const std::string& word : split(specification, ',')) {
+        const Date start{remove_whitespace(word)};
+        if (!starts_.empty() && start <= starts_.back()) {
+          error("The start dates of the seasons '" + specification
+                + "' are not in increasing order.");
+        }
+        starts_.push_back(start);
+      }
+      if (starts_.empty()) {
+        error("The seasons '" + specification
+              + "' are neither yearly, quarterly, nor a list of start dates.");
+      }
+    }
+  }
+
+  static inline const std::string Yearly{"yearly"};
+
+  static inline const std::string Quarterly{"quarterly"};
+
+  /// \brief Name of the season of a date, such as "2020" for a year,
+  /// "2020-Q1" for a quarter, or the start date of the season. Empty if the
+  /// date belongs to no season.
+  std::optional<std::string> name(const Date& date) const noexcept {
+    switch (period_) {
+      case Period::Year:
+        return std::to_string(date.year());
+      case Period::Quarter:
+        return std::to_string(date.year()) + "-Q"
+               + std::to_string((date.month_number() - 1) / 3 + 1);
+      case Period::None:
+        break;
+    }
+    const std::vector<Date>::const_iterator next{
+        std::upper_bound(starts_.cbegin(), starts_.cend(), date)};
+    if (next == starts_.cbegin()) {
+      return {};
+    }
+    return (next - 1)->print();
+  }
+
+private:
+  enum class Period : int8_t {
+    None,
+    Year,
+    Quarter,
+  };
+
+  Period period_{Period::None};
+
+  std::vector<Date> starts_;
+};
+
+}  // namespace CatanRanker
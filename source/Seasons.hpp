@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Leaderboard.hpp"
+#include "SeasonSchedule.hpp"
+#include "SeasonsFileWriter.hpp"
+
+namespace CatanRanker {
+
+/// \brief Seasons into which the games are split, such as years. The ratings
+/// are reset at the start of each season. The games are sorted, so each season
+/// is a range of consecutive games, and the players of the seasons are
+/// computed concurrently. Each season's leaderboard has the same layout as the
+/// leaderboard of every game and is written to a directory named after the
+/// season in the seasons directory of that leaderboard.
+class Seasons {
+public:
+  Seasons(const SeasonSchedule& schedule, const Games& games,
+          Context& context, TaskScheduler& scheduler,
+          const std::experimental::filesystem::path& streaming_directory = {}) {
+    struct Range {
+      std::string name;
+
+      std::size_t begin;
+
+      std::size_t end;
+    };
+    std::vector<Range> ranges;
+    for (std::size_t index = 0; index < games.size(); ++index) {
+      const std::optional<std::string> name{
+          schedule.name(games[index].date())};
+      if (!name.has_value()) {
+        continue;
+      }
+      if (!ranges.empty() && ranges.back().name == name.value()
+          && ranges.back().end == index) {
+        ++ranges.back().end;
+      } else {
+        ranges.push_back({name.value(), index, index + 1});
+      }
+    }
+    if (!streaming_directory.empty()) {
+      create(streaming_directory / Path::SeasonsDirectoryName);
+    }
+    data_.resize(ranges.size());
+    TaskGraph graph;
+    for (std::size_t index = 0; index < ranges.size(); ++index) {
+      graph.add([&, index]() {
+        const Range& range{ranges[index]};
+        CATAN_RANKER_TRACE_SPAN(
+            context.tracer, "season", "Season " + range.name);
+        data_[index] = std::make_unique<Season>(
+            range.name, games, range.begin, range.end, context,
+            streaming_directory.empty() ?
+                std::experimental::filesystem::path{} :
+                directory(streaming_directory, range.name));
+      });
+    }
+    graph.run(scheduler);
+    message("Computed " + std::to_string(data_.size()) + " seasons.");
+  }
+
+  /// \brief Write the leaderboard of each season and the index of the seasons
+  /// in the seasons directory of a leaderboard. Each season's leaderboard is
+  /// written by the task scheduler in turn.
+  void write(const std::experimental::filesystem::path& base_directory,
+             Context& context, TaskScheduler& scheduler) const {
+    create(base_directory / Path::SeasonsDirectoryName);
+    for (const std::unique_ptr<Season>& season : data_) {
+      Leaderboard{directory(base_directory, season->name()), season->games(),
+                  season->players(), context, scheduler};
+      message("Wrote the leaderboard of season " + season->name() + ".");
+    }
+    SeasonsFileWriter{base_directory / Path::SeasonsDirectoryName, data_};
+  }
+
+  bool empty() const noexcept {
+    return data_.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return data_.size();
+  }
+
+private:
+  std::vector<std::unique_ptr<Season>> data_;
+
+  static std::experimental::filesystem::path directory(
+      const std::experimental::filesystem::path& base_directory,
+      const std::string& name) noexcept {
+    return base_directory / Path::SeasonsDirectoryName / name;
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MarkdownFileWriter.hpp"
+#include "Path.hpp"
+#include "Season.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writer of the index of the seasons, which links to the leaderboard of
+/// each season and summarizes it.
+class SeasonsFileWriter : public MarkdownFileWriter {
+public:
+  SeasonsFileWriter(const std::experimental::filesystem::path& directory,
+                    const std::vector<std::unique_ptr<Season>>&
+                        seasons) noexcept
+    : MarkdownFileWriter(directory / Path::LeaderboardFileName, "Seasons") {
+    line("Last updated " + current_utc_date_and_time() + ".");
+    blank_line();
+    line("The ratings are reset at the start of each season.");
+    blank_line();
+    Column name{"Season", Column::Alignment::Left};
+    Column first_date{"First Game", Column::Alignment::Center};
+    Column last_date{"Last Game", Column::Alignment::Center};
+    Column number_of_games{"Games", Column::Alignment::Center};
+    Column number_of_players{"Players", Column::Alignment::Center};
+    Column leader{"Highest Rating", Column::Alignment::Left};
+    for (const std::unique_ptr<Season>& season : seasons) {
+      name.add_row("[" + season->name() + "](" + season->name() + ")");
+      first_date.add_row(season->games().cbegin()->date());
+      last_date.add_row(season->games().crbegin()->date());
+      number_of_games.add_row(static_cast<int64_t>(season->games().size()));
+      number_of_players.add_row(
+          static_cast<int64_t>(season->players().size()));
+      leader.add_row(highest_rating(season->players()));
+    }
+    const Table data{
+        {name, first_date, last_date, number_of_games, number_of_players,
+         leader}
+    };
+    table(data);
+    blank_line();
+    line("[(Back to Main Page)](../#)");
+    blank_line();
+  }
+
+private:
+  /// \brief Player with the highest current Elo rating in all games and that
+  /// rating, such as "Alice (1150)".
+  static std::string highest_rating(const Players& players) noexcept {
+    const Player* highest{nullptr};
+    for (const Player& player : players) {
+      if (highest == nullptr
+          || highest->elo_rating(GameCategory::AnyNumberOfPlayers)
+                 < player.elo_rating(GameCategory::AnyNumberOfPlayers)) {
+        highest = &player;
+      }
+    }
+    if (highest == nullptr) {
+      return "";
+    }
+    return highest->name().value() + " ("
+           + highest->elo_rating(GameCategory::AnyNumberOfPlayers).print()
+           + ")";
+  }
+};
+
+}  // namespace CatanRanker
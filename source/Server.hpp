@@ -0,0 +1,612 @@
+#pragma once
+
+#include "Queries.hpp"
+
+namespace CatanRanker {
+
+/// \brief Server that answers queries from memory over a Unix domain socket, a
+/// loopback HTTP port, or both. On the Unix domain socket, each request is a
+/// line of text containing a query, such as "ratings 3-4", and each answer is a
+/// line containing a JSON document. The special request "shutdown" stops the
+/// server. A client that shuts down its side of the connection still receives
+/// the answers to the requests it sent, including a last line without a
+/// newline. Over HTTP, the queries are GET requests such as
+/// "/leaderboard?category=3-4" and the connections are kept alive. The server
+/// also stops on the SIGINT and SIGTERM signals. Every connection is served by
+/// a single thread through an epoll event loop, so queries never run
+/// concurrently.
+class Server {
+public:
+  /// \brief The socket file is not used if it is empty, and the HTTP port is
+  /// not used if it is empty. An HTTP port of 0 is any free port.
+  Server(const std::experimental::filesystem::path& socket_file,
+         const std::optional<int64_t>& http_port, Queries& queries) noexcept
+    : socket_file_(socket_file), http_port_(http_port), queries_(queries) {}
+
+  Server(const Server&) = delete;
+
+  Server& operator=(const Server&) = delete;
+
+  ~Server() noexcept {
+    for (const std::pair<const int, Connection>& connection : connections_) {
+      close(connection.first);
+    }
+    for (const int listener : {socket_listener_, http_listener_, epoll_}) {
+      if (listener >= 0) {
+        close(listener);
+      }
+    }
+  }
+
+  /// \brief Serve requests until the server is stopped. The socket file is
+  /// created when the server starts and removed when it stops.
+  void run() {
+    epoll_ = epoll_create1(0);
+    if (epoll_ < 0) {
+      error("Could not create the event loop of the server.");
+    }
+    if (!socket_file_.empty()) {
+      socket_listener_ = open_socket_file();
+      watch(socket_listener_, EPOLLIN);
+      message("Serving queries on: " + socket_file_.string());
+    }
+    if (http_port_.has_value()) {
+      http_listener_ = open_http_port();
+      watch(http_listener_, EPOLLIN);
+      message("Serving queries on: http://127.0.0.1:"
+              + std::to_string(bound_http_port()));
+    }
+    stop_requested_ = 0;
+    struct sigaction action {};
+    action.sa_handler = &Server::request_stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    std::array<epoll_event, 64> events;
+    while (stop_requested_ == 0) {
+      // Messages are written before waiting so that they appear while the
+      // server is idle.
+      flush_console();
+      const int number_of_events{
+          epoll_wait(epoll_, events.data(), events.size(), -1)};
+      if (number_of_events < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        error("Could not wait for requests.");
+      }
+      for (int index = 0; index < number_of_events; ++index) {
+        const int descriptor{events[index].data.fd};
+        if (descriptor == socket_listener_) {
+          accept_connections(socket_listener_, Protocol::Lines);
+        } else if (descriptor == http_listener_) {
+          accept_connections(http_listener_, Protocol::Http);
+        } else {
+          serve(descriptor, events[index].events);
+        }
+      }
+    }
+    if (!socket_file_.empty()) {
+      std::experimental::filesystem::remove(socket_file_);
+    }
+    message("Stopped serving queries.");
+  }
+
+private:
+  enum class Protocol : int8_t {
+    /// \brief One query per line, one JSON answer per line.
+    Lines,
+
+    /// \brief HTTP/1.1 GET requests with JSON responses.
+    Http
+  };
+
+  /// \brief State of a client connection.
+  struct Connection {
+    Protocol protocol{Protocol::Lines};
+
+    /// \brief Received bytes that do not yet form a complete request.
+    std::string input;
+
+    /// \brief Answers that could not yet be sent.
+    std::string output;
+
+    /// \brief Whether the connection is closed once the output is sent, either
+    /// because the client sent no more input or because of the last request.
+    bool closing{false};
+
+    /// \brief Events for which the event loop waits on the connection: more
+    /// input unless the connection is closing, and accepting more output if
+    /// some answers could not yet be sent.
+    uint32_t watched{EPOLLIN};
+  };
+
+  /// \brief Maximum length of a request. Clients that send longer requests are
+  /// disconnected.
+  static constexpr std::size_t MaximumRequestSize{1 << 20};
+
+  inline static volatile std::sig_atomic_t stop_requested_{0};
+
+  std::experimental::filesystem::path socket_file_;
+
+  std::optional<int64_t> http_port_;
+
+  Queries& queries_;
+
+  int epoll_{-1};
+
+  int socket_listener_{-1};
+
+  int http_listener_{-1};
+
+  std::map<int, Connection> connections_;
+
+  static void request_stop(const int) noexcept {
+    stop_requested_ = 1;
+  }
+
+  void watch(const int descriptor, const uint32_t events) const {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = descriptor;
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, descriptor, &event) < 0) {
+      error("Could not watch a connection of the server.");
+    }
+  }
+
+  void rewatch(const int descriptor, const uint32_t events) const noexcept {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = descriptor;
+    epoll_ctl(epoll_, EPOLL_CTL_MOD, descriptor, &event);
+  }
+
+  /// \brief Create, bind, and listen on the Unix domain socket. A socket file
+  /// left behind by a previous server is replaced.
+  int open_socket_file() const {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_file_.string().size() >= sizeof(address.sun_path)) {
+      error("The socket path is too long: " + socket_file_.string());
+    }
+    std::strncpy(address.sun_path, socket_file_.string().c_str(),
+                 sizeof(address.sun_path) - 1);
+    if (std::experimental::filesystem::exists(socket_file_)) {
+      if (!std::experimental::filesystem::is_socket(socket_file_)) {
+        error("The socket path exists and is not a socket: "
+              + socket_file_.string());
+      }
+      std::experimental::filesystem::remove(socket_file_);
+    }
+    const int listener{socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0)};
+    if (listener < 0
+        || bind(listener, reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address))
+               < 0
+        || listen(listener, SOMAXCONN) < 0) {
+      error("Could not listen on the socket: " + socket_file_.string());
+    }
+    return listener;
+  }
+
+  /// \brief Create, bind, and listen on the HTTP port of the loopback
+  /// interface, so that the server cannot be reached from other hosts.
+  int open_http_port() const {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(http_port_.value()));
+    const int listener{socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0)};
+    const int reuse{1};
+    if (listener < 0
+        || setsockopt(
+               listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse))
+               < 0
+        || bind(listener, reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address))
+               < 0
+        || listen(listener, SOMAXCONN) < 0) {
+      error("Could not listen on the HTTP port: "
+            + std::to_string(http_port_.value()));
+    }
+    return listener;
+  }
+
+  /// \brief Port on which the HTTP listener is bound, which differs from the
+  /// requested port if any free port was requested.
+  int64_t bound_http_port() const noexcept {
+    sockaddr_in address{};
+    socklen_t length{sizeof(address)};
+    getsockname(
+        http_listener_, reinterpret_cast<sockaddr*>(&address), &length);
+    return ntohs(address.sin_port);
+  }
+
+  void accept_connections(const int listener, const Protocol protocol) {
+    while (true) {
+      const int client{accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)};
+      if (client < 0) {
+        return;
+      }
+      if (protocol == Protocol::Http) {
+        const int no_delay{1};
+        setsockopt(
+            client, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+      }
+      Connection connection;
+      connection.protocol = protocol;
+      connections_.emplace(client, std::move(connection));
+      watch(client, EPOLLIN);
+    }
+  }
+
+  /// \brief Read what a client sent, answer each of its complete requests, and
+  /// send as much of the answers as the connection accepts.
+  void serve(const int client, const uint32_t events) noexcept {
+    const std::map<int, Connection>::iterator found{connections_.find(client)};
+    if (found == connections_.end()) {
+      return;
+    }
+    Connection& connection{found->second};
+    bool disconnected{(events & (EPOLLERR | EPOLLHUP)) != 0};
+    if ((events & EPOLLIN) != 0 && !connection.closing) {
+      // A client that shuts down its side of the connection after sending its
+      // requests still receives the answers, so the end of the input only
+      // closes the connection once the output is sent.
+      bool end_of_input{false};
+      char chunk[16384];
+      while (true) {
+        const ssize_t size{recv(client, chunk, sizeof(chunk), 0)};
+        if (size > 0) {
+          connection.input.append(chunk, static_cast<std::size_t>(size));
+        } else {
+          if (size == 0) {
+            end_of_input = true;
+          } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            disconnected = true;
+          }
+          break;
+        }
+      }
+      if (connection.protocol == Protocol::Lines) {
+        if (end_of_input && !trim(connection.input).empty()) {
+          connection.input += '\n';
+        }
+        answer_lines(connection);
+      } else {
+        answer_http(connection);
+      }
+      if (end_of_input) {
+        connection.closing = true;
+      }
+      if (connection.input.size() > MaximumRequestSize) {
+        const std::string failure{
+            Queries::failure("The request is too long.")};
+        connection.output += connection.protocol == Protocol::Lines ?
+                                 failure + "\n" :
+                                 http_response(413, failure, false, false);
+        connection.closing = true;
+      }
+    }
+    if (!disconnected && !send_output(client, connection)) {
+      disconnected = true;
+    }
+    if (disconnected || (connection.closing && connection.output.empty())) {
+      close(client);
+      connections_.erase(found);
+    } else {
+      const uint32_t watched{
+          (connection.closing ? 0u : static_cast<uint32_t>(EPOLLIN))
+          | (connection.output.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT))};
+      if (watched != connection.watched) {
+        connection.watched = watched;
+        rewatch(client, watched);
+      }
+    }
+  }
+
+  /// \brief Send as much of the output of a connection as it accepts. Returns
+  /// false if the client disconnected.
+  static bool send_output(const int client, Connection& connection) noexcept {
+    std::size_t sent{0};
+    while (sent < connection.output.size()) {
+      const ssize_t size{send(client, connection.output.data() + sent,
+                              connection.output.size() - sent, MSG_NOSIGNAL)};
+      if (size < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          break;
+        }
+        return false;
+      }
+      sent += static_cast<std::size_t>(size);
+    }
+    connection.output.erase(0, sent);
+    return true;
+  }
+
+  /// \brief Answer each complete line received on a Unix domain socket.
+  void answer_lines(Connection& connection) noexcept {
+    std::size_t begin{0};
+    for (std::size_t end = connection.input.find('\n');
+         end != std::string::npos && !connection.closing;
+         end = connection.input.find('\n', begin)) {
+      const std::string request{
+          trim(connection.input.substr(begin, end - begin))};
+      begin = end + 1;
+      if (request.empty()) {
+        continue;
+      } else if (request == "shutdown") {
+        stop_requested_ = 1;
+        connection.output += "{\"shutdown\": true}\n";
+        connection.closing = true;
+      } else {
+        connection.output += timed(request, [&]() {
+          return queries_.answer(request);
+        }) + "\n";
+      }
+    }
+    connection.input.erase(0, begin);
+  }
+
+  /// \brief Answer each complete HTTP request received on the HTTP port. The
+  /// body of a request, if any, is ignored.
+  void answer_http(Connection& connection) noexcept {
+    while (!connection.closing) {
+      const std::size_t headers_end{connection.input.find("\r\n\r\n")};
+      if (headers_end == std::string::npos) {
+        return;
+      }
+      const std::vector<std::string> lines{
+          split_lines(connection.input.substr(0, headers_end))};
+      const std::vector<std::string> request_line{
+          lines.empty() ? std::vector<std::string>{} :
+                          split_by_whitespace(lines.front())};
+      std::size_t body_length{0};
+      bool keep_alive{request_line.size() == 3
+                      && request_line[2] != "HTTP/1.0"};
+      for (std::size_t index = 1; index < lines.size(); ++index) {
+        const std::size_t colon{lines[index].find(':')};
+        const std::string name{lowercase(lines[index].substr(0, colon))};
+        const std::string value{
+            colon != std::string::npos ?
+                lowercase(trim(lines[index].substr(colon + 1))) :
+                std::string{}};
+        if (name == "content-length") {
+          const std::optional<int64_t> length{string_to_integer_number(value)};
+          body_length = length.has_value() && length.value() > 0 ?
+                            static_cast<std::size_t>(length.value()) :
+                            0;
+        } else if (name == "connection") {
+          keep_alive = value == "keep-alive" ? true :
+                       value == "close"      ? false :
+                                               keep_alive;
+        }
+      }
+      if (connection.input.size() < headers_end + 4 + body_length) {
+        return;
+      }
+      connection.input.erase(0, headers_end + 4 + body_length);
+      if (request_line.size() != 3) {
+        connection.output += http_response(
+            400, Queries::failure("Malformed request."), false, false);
+        connection.closing = true;
+        return;
+      }
+      const bool head{request_line[0] == "HEAD"};
+      if (request_line[0] != "GET" && !head) {
+        connection.output += http_response(
+            405, Queries::failure("Only GET requests are supported."), head,
+            keep_alive);
+      } else {
+        const std::string& target{request_line[1]};
+        connection.output += timed(target, [&]() {
+          return http_answer(target, head, keep_alive);
+        });
+      }
+      connection.closing = !keep_alive;
+    }
+  }
+
+  /// \brief HTTP response to a GET request for a target, such as
+  /// "/players/Alice?category=3-4".
+  std::string http_answer(const std::string& target, const bool head,
+                          const bool keep_alive) noexcept {
+    const std::size_t question_mark{target.find('?')};
+    const std::string path{url_decode(target.substr(0, question_mark))};
+    std::map<std::string, std::string> parameters;
+    if (question_mark != std::string::npos) {
+      for (const std::string& parameter :
+           split(target.substr(question_mark + 1), '&')) {
+        const std::size_t equals{parameter.find('=')};
+        parameters[url_decode(parameter.substr(0, equals))] =
+            equals != std::string::npos ?
+                url_decode(parameter.substr(equals + 1)) :
+                std::string{};
+      }
+    }
+    const auto parameter = [&](const std::string& name) -> std::string {
+      const std::map<std::string, std::string>::const_iterator found{
+          parameters.find(name)};
+      return found != parameters.cend() ? found->second : std::string{};
+    };
+    const auto date = [&](const std::string& name) -> std::optional<Date> {
+      const std::string value{parameter(name)};
+      return value.empty() ? std::optional<Date>{} :
+                             std::optional<Date>{Date{value}};
+    };
+    // Parameters that cannot be parsed are answered with status 400, and
+    // players who have played no game with status 404.
+    const auto number_of_players = [&]() -> std::size_t {
+      if (parameter("top").empty()) {
+        return std::numeric_limits<std::size_t>::max();
+      }
+      const std::optional<int64_t> number{
+          string_to_integer_number(parameter("top"))};
+      if (!number.has_value() || number.value() < 1) {
+        error("The number of players must be a positive integer.");
+      }
+      return static_cast<std::size_t>(number.value());
+    };
+    const auto unknown_player = [&](const PlayerName& player_name) {
+      return http_response(
+          404, Queries::failure(player_name.value() + " is not a player."),
+          head, keep_alive);
+    };
+    const std::string players_prefix{"/players/"};
+    const std::string ranks_suffix{"/ranks"};
+    try {
+      if (path == "/players") {
+        return http_response(
+            200,
+            parameter("at").empty() ?
+                queries_.ratings(
+                    Queries::game_category(parameter("category"))) :
+                queries_.ratings(
+                    queries_.moments(parameter("at")),
+                    Queries::game_category(parameter("category"))),
+            head, keep_alive);
+      } else if (path.compare(0, players_prefix.size(), players_prefix) == 0
+                 && path.size() > ranks_suffix.size() + players_prefix.size()
+                 && path.compare(path.size() - ranks_suffix.size(),
+                                 ranks_suffix.size(), ranks_suffix)
+                        == 0) {
+        const PlayerName player_name{path.substr(
+            players_prefix.size(),
+            path.size() - players_prefix.size() - ranks_suffix.size())};
+        if (!queries_.contains(player_name)) {
+          return unknown_player(player_name);
+        }
+        return http_response(
+            200,
+            queries_.ranks(
+                player_name, Queries::game_category(parameter("category"))),
+            head, keep_alive);
+      } else if (path.compare(0, players_prefix.size(), players_prefix) == 0
+                 && path.size() > players_prefix.size()) {
+        const PlayerName player_name{path.substr(players_prefix.size())};
+        if (!queries_.contains(player_name)) {
+          return unknown_player(player_name);
+        }
+        return http_response(
+            200,
+            parameter("at").empty() ?
+                queries_.history(
+                    player_name,
+                    Queries::game_category(parameter("category"))) :
+                queries_.rating(
+                    player_name, Moment::parse(parameter("at")),
+                    Queries::game_category(parameter("category"))),
+            head, keep_alive);
+      } else if (path == "/leaderboard") {
+        const std::size_t number{number_of_players()};
+        return http_response(
+            200,
+            parameter("at").empty() ?
+                queries_.leaderboard(
+                    Queries::game_category(parameter("category")), number) :
+                queries_.top(number, Moment::parse(parameter("at")),
+                             Queries::game_category(parameter("category"))),
+            head, keep_alive);
+      } else if (path == "/games") {
+        return http_response(
+            200, queries_.games(date("from"), date("to")), head, keep_alive);
+      }
+    } catch (const std::exception& exception) {
+      return http_response(
+          400, Queries::failure(exception.what()), head, keep_alive);
+    }
+    return http_response(
+        404,
+        Queries::failure("Unknown path: '" + path
+                         + "'. Expected /players, /players/<name>, "
+                           "/players/<name>/ranks, /leaderboard, or /games."),
+        head, keep_alive);
+  }
+
+  static std::string http_response(
+      const int64_t status, const std::string& body, const bool head,
+      const bool keep_alive) noexcept {
+    const std::string content{body + "\n"};
+    return "HTTP/1.1 " + std::to_string(status) + " " + reason(status)
+           + "\r\nContent-Type: application/json\r\nContent-Length: "
+           + std::to_string(content.size()) + "\r\nConnection: "
+           + (keep_alive ? "keep-alive" : "close") + "\r\n\r\n"
+           + (head ? std::string{} : content);
+  }
+
+  static std::string reason(const int64_t status) noexcept {
+    switch (status) {
+      case 200:
+        return "OK";
+      case 400:
+        return "Bad Request";
+      case 404:
+        return "Not Found";
+      case 405:
+        return "Method Not Allowed";
+      case 413:
+        return "Payload Too Large";
+      default:
+        return "Error";
+    }
+  }
+
+  /// \brief Decode the percent-encoded characters of a URL component, and
+  /// replace plus signs with spaces.
+  static std::string url_decode(const std::string& text) noexcept {
+    std::string decoded;
+    for (std::size_t index = 0; index < text.size(); ++index) {
+      if (text[index] == '%' && index + 2 < text.size()
+          && std::isxdigit(static_cast<unsigned char>(text[index + 1]))
+          && std::isxdigit(static_cast<unsigned char>(text[index + 2]))) {
+        decoded += static_cast<char>(
+            std::stoi(text.substr(index + 1, 2), nullptr, 16));
+        index += 2;
+      } else if (text[index] == '+') {
+        decoded += ' ';
+      } else {
+        decoded += text[index];
+      }
+    }
+    return decoded;
+  }
+
+  /// \brief Split the header block of an HTTP request into lines.
+  static std::vector<std::string> split_lines(
+      const std::string& text) noexcept {
+    std::vector<std::string> lines;
+    std::size_t begin{0};
+    while (begin <= text.size()) {
+      std::size_t end{text.find("\r\n", begin)};
+      if (end == std::string::npos) {
+        end = text.size();
+      }
+      lines.push_back(text.substr(begin, end - begin));
+      begin = end + 2;
+    }
+    return lines;
+  }
+
+  /// \brief Answer a request and print how long it took at the debug level.
+  template <typename Function>
+  static std::string timed(
+      const std::string& request, const Function& function) noexcept {
+    const std::chrono::steady_clock::time_point start{
+        std::chrono::steady_clock::now()};
+    std::string answer{function()};
+    debug([&]() {
+      return "Answered '" + request + "' in "
+             + std::to_string(
+                 std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count())
+             + " us.";
+    });
+    return answer;
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace CatanRanker {
+
+/// \brief Settings that control how the leaderboard files are written.
+struct Settings {
+  /// \brief Whether the plots of each directory are generated by a single
+  /// Gnuplot batch script instead of one Gnuplot process per plot.
+  bool gnuplot_batch{false};
+
+  /// \brief Whether the player data files are also written in Gnuplot's binary
+  /// format, in which case the Gnuplot files read the binary data files.
+  bool binary_data_files{false};
+
+  /// \brief Whether the plotted series are downsampled to a number of points
+  /// proportional to the width of the plots.
+  bool downsample_plots{false};
+
+  /// \brief Whether Gnuplot is run to generate the plots. If not, the Gnuplot
+  /// files are still written but no plot is generated.
+  bool generate_plots{true};
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "Players.hpp"
+
+namespace CatanRanker {
+
+/// \brief Index of the full ranking of the players of a game category after
+/// every game of that game category, from which the ranking at any moment is
+/// obtained without replaying the games. The players are ranked from the
+/// highest to the lowest rating, and players with equal ratings are ranked by
+/// name.
+///
+/// Every rating that a player has in the game category is a key, and the keys
+/// are sorted by rank. The ranking after each game is a persistent segment
+/// tree that counts the players whose current rating is each key. A game
+/// removes the previous keys of its participants and inserts their new keys,
+/// and only copies the nodes on the paths to these keys, so each version
+/// shares every other node with the version before it. The rank of a player
+/// and the player at a rank are found in a time proportional to the logarithm
+/// of the number of keys.
+class Standings {
+public:
+  Standings(const Games& games, const Players& players,
+            const GameCategory game_category) noexcept
+    : games_(games), game_category_(game_category) {
+    // Assign each player an identifier, by name.
+    for (const Player& player : players) {
+      players_.push_back(&player);
+    }
+    // Collect every key, and the game at which each player obtains each key.
+    struct Change {
+      int64_t game_category_game_number;
+
+      int32_t player_identifier;
+
+      Key key;
+    };
+    std::vector<Change> changes;
+    for (std::size_t identifier = 0; identifier < players_.size();
+         ++identifier) {
+      for (const PlayerProperties& properties :
+           (*players_[identifier])[game_category]) {
+        const Key key{properties.elo_rating().value(),
+                      static_cast<int32_t>(identifier)};
+        keys_.push_back(key);
+        changes.push_back(
+            {properties.game_category_game_number(),
+             static_cast<int32_t>(identifier), key});
+      }
+    }
+    std::sort(keys_.begin(), keys_.end(), Key::sort());
+    keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+    std::stable_sort(changes.begin(), changes.end(),
+                     [](const Change& change_1, const Change& change_2) {
+                       return change_1.game_category_game_number
+                              < change_2.game_category_game_number;
+                     });
+    // Build one version of the ranking per game. The nodes created for a
+    // version are not shared yet, so they are modified in place rather than
+    // copied again when the same game changes several keys.
+    nodes_.push_back({0, 0, 0});
+    const std::size_t number_of_games{
+        games.game_indices(game_category).size()};
+    roots_.reserve(number_of_games + 1);
+    roots_.push_back(0);
+    std::vector<int32_t> positions(players_.size(), -1);
+    std::vector<Change>::const_iterator change{changes.cbegin()};
+    for (std::size_t game_number = 1; game_number <= number_of_games;
+         ++game_number) {
+      first_unshared_node_ = static_cast<int32_t>(nodes_.size());
+      int32_t root{roots_.back()};
+      for (; change < changes.cend()
+             && change->game_category_game_number
+                    == static_cast<int64_t>(game_number);
+           ++change) {
+        int32_t& position{positions[change->player_identifier]};
+        if (position >= 0) {
+          root = update(root, 0, keys_.size(), position, -1);
+        }
+        position = this->position(change->key);
+        root = update(root, 0, keys_.size(), position, 1);
+      }
+      roots_.push_back(root);
+    }
+  }
+
+  GameCategory game_category() const noexcept {
+    return game_category_;
+  }
+
+  /// \brief Number of games of the game category at or before a moment, which
+  /// identifies the version of the ranking at that moment.
+  std::size_t version(const Moment& moment) const noexcept {
+    const std::size_t number_of_games{static_cast<std::size_t>(
+        std::partition_point(games_.cbegin(), games_.cend(),
+                             [&moment](const Game& game) {
+                               return moment.includes(
+                                   game.number(), game.date());
+                             })
+        - games_.cbegin())};
+    const std::vector<std::size_t>& indices{
+        games_.game_indices(game_category_)};
+    return static_cast<std::size_t>(
+        std::lower_bound(indices.cbegin(), indices.cend(), number_of_games)
+        - indices.cbegin());
+  }
+
+  /// \brief Number of ranked players in a version of the ranking, which are
+  /// the players who had played at least one game of the game category.
+  std::size_t number_of_players(const std::size_t version) const noexcept {
+    return static_cast<std::size_t>(nodes_[roots_[version]].count);
+  }
+
+  /// \brief Properties of a player in a version of the ranking. Null if the
+  /// player had not played any game of the game category.
+  const PlayerProperties* properties(
+      const Player& player, const std::size_t version) const noexcept {
+    const std::vector<PlayerProperties>& history{player[game_category_]};
+    const std::vector<PlayerProperties>::const_iterator end{
+        std::partition_point(history.cbegin(), history.cend(),
+                             [version](const PlayerProperties& properties) {
+                               return properties.game_category_game_number()
+                                      <= static_cast<int64_t>(version);
+                             })};
+    return end != history.cbegin() ? &*(end - 1) : nullptr;
+  }
+
+  /// \brief Rank of a player in a version of the ranking, starting from 1.
+  /// Empty if the player had not played any game of the game category.
+  std::optional<std::size_t> rank(
+      const Player& player, const std::size_t version) const noexcept {
+    const PlayerProperties* const properties{
+        this->properties(player, version)};
+    if (properties == nullptr) {
+      return {};
+    }
+    const std::size_t target{static_cast<std::size_t>(position(
+        {properties->elo_rating().value(), identifier(player.name())}))};
+    // Count the ranked players whose keys come before the player's key.
+    std::size_t count{0};
+    int32_t node{roots_[version]};
+    std::size_t begin{0};
+    std::size_t size{keys_.size()};
+    while (node != 0 && size > 1) {
+      const std::size_t middle{begin + size / 2};
+      if (target < middle) {
+        node = nodes_[node].left;
+        size = middle - begin;
+      } else {
+        count += static_cast<std::size_t>(nodes_[nodes_[node].left].count);
+        node = nodes_[node].right;
+        size -= middle - begin;
+        begin = middle;
+      }
+    }
+    return count + 1;
+  }
+
+  /// \brief Highest ranked players of a version of the ranking, from the first
+  /// rank.
+  std::vector<const Player*> top(const std::size_t version,
+                                 const std::size_t number) const noexcept {
+    std::vector<const Player*> ranking;
+    ranking.reserve(std::min(number, number_of_players(version)));
+    collect(roots_[version], 0, keys_.size(), number, ranking);
+    return ranking;
+  }
+
+private:
+  /// \brief Rating of a player and identifier of that player. The identifier
+  /// breaks ties between players with equal ratings.
+  struct Key {
+    double rating;
+
+    int32_t player_identifier;
+
+    bool operator==(const Key& other) const noexcept {
+      return rating == other.rating
+             && player_identifier == other.player_identifier;
+    }
+
+    struct sort {
+      bool operator()(const Key& key_1, const Key& key_2) const noexcept {
+        if (key_1.rating != key_2.rating) {
+          return key_1.rating > key_2.rating;
+        }
+        return key_1.player_identifier < key_2.player_identifier;
+      }
+    };
+  };
+
+  /// \brief Node of the segment tree over the keys. Node 0 is the empty tree.
+  struct Node {
+    int32_t left;
+
+    int32_t right;
+
+    int32_t count;
+  };
+
+  const Games& games_;
+
+  GameCategory game_category_;
+
+  /// \brief Players by identifier, which is their index in this vector.
+  std::vector<const Player*> players_;
+
+  /// \brief Keys by rank.
+  std::vector<Key> keys_;
+
+  std::vector<Node> nodes_;
+
+  /// \brief Root node of the ranking after each game of the game category.
+  /// The first root is the empty ranking before the first game.
+  std::vector<int32_t> roots_;
+
+  /// \brief First node that belongs to the version being built. Nodes before
+  /// it are shared by earlier versions and must be copied before they are
+  /// modified.
+  int32_t first_unshared_node_{0};
+
+  int32_t identifier(const PlayerName& player_name) const noexcept {
+    return static_cast<int32_t>(
+        std::lower_bound(players_.cbegin(), players_.cend(), player_name,
+                         [](const Player* player, const PlayerName& name) {
+                           return PlayerName::sort()(player->name(), name);
+                         })
+        - players_.cbegin());
+  }
+
+  int32_t position(const Key& key) const noexcept {
+    return static_cast<int32_t>(
+        std::lower_bound(keys_.cbegin(), keys_.cend(), key, Key::sort())
+        - keys_.cbegin());
+  }
+
+  /// \brief Add a count to the key at a position of the subtree of a node that
+  /// covers the keys from a beginning to an end, and return the new node of
+  /// that subtree.
+  int32_t update(const int32_t node, const std::size_t begin,
+                 const std::size_t end, const int32_t position,
+                 const int32_t count) noexcept {
+    int32_t updated{node};
+    if (updated < first_unshared_node_) {
+      nodes_.push_back(nodes_[node]);
+      updated = static_cast<int32_t>(nodes_.size() - 1);
+    }
+    nodes_[updated].count += count;
+    if (end - begin > 1) {
+      const std::size_t middle{begin + (end - begin) / 2};
+      if (static_cast<std::size_t>(position) < middle) {
+        const int32_t left{
+            update(nodes_[updated].left, begin, middle, position, count)};
+        nodes_[updated].left = left;
+      } else {
+        const int32_t right{
+            update(nodes_[updated].right, middle, end, position, count)};
+        nodes_[updated].right = right;
+      }
+    }
+    return updated;
+  }
+
+  /// \brief Append the players of the subtree of a node, in order of rank,
+  /// until the ranking contains a given number of players.
+  void collect(const int32_t node, const std::size_t begin,
+               const std::size_t end, const std::size_t number,
+               std::vector<const Player*>& ranking) const noexcept {
+    if (node == 0 || nodes_[node].count == 0 || ranking.size() >= number) {
+      return;
+    }
+    if (end - begin == 1) {
+      ranking.push_back(players_[keys_[begin].player_identifier]);
+      return;
+    }
+    const std::size_t middle{begin + (end - begin) / 2};
+    collect(nodes_[node].left, begin, middle, number, ranking);
+    collect(nodes_[node].right, middle, end, number, ranking);
+  }
+};
+
+}  // namespace CatanRanker
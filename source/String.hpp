@@ -5,10 +5,25 @@
 namespace CatanRanker {
 
 /// \brief Split a string into words using whitespace as a delimiter.
+/// Scanned directly rather than through a string stream because it is called
+/// for every row of every data file that is read back.
 std::vector<std::string> split_by_whitespace(const std::string& text) noexcept {
-  std::istringstream stream{text};
-  std::vector<std::string> words{std::istream_iterator<std::string>{stream},
-                                 std::istream_iterator<std::string>{}};
+  std::vector<std::string> words;
+  std::size_t index{0};
+  while (index < text.size()) {
+    while (index < text.size()
+           && std::isspace(static_cast<unsigned char>(text[index]))) {
+      ++index;
+    }
+    const std::size_t begin{index};
+    while (index < text.size()
+           && !std::isspace(static_cast<unsigned char>(text[index]))) {
+      ++index;
+    }
+    if (index > begin) {
+      words.emplace_back(text, begin, index - begin);
+    }
+  }
   return words;
 }
 
@@ -43,6 +58,16 @@ std::string remove_whitespace(const std::string& text) noexcept {
   return new_text;
 }
 
+/// \brief Remove the whitespace at the beginning and at the end of a string.
+std::string trim(const std::string& text) noexcept {
+  const std::size_t begin{text.find_first_not_of(" \t\r\n")};
+  if (begin == std::string::npos) {
+    return {};
+  }
+  const std::size_t end{text.find_last_not_of(" \t\r\n")};
+  return text.substr(begin, end - begin + 1);
+}
+
 /// \brief Remove non-alphanumeric characters in a string.
 std::string remove_non_alphanumeric_characters(
     const std::string& text) noexcept {
@@ -23,11 +23,16 @@ public:
   }
 
   std::string print_as_markdown() const noexcept {
+    // The width of each column is computed once rather than once per row.
+    std::vector<int64_t> widths;
+    for (const Column& column : columns_) {
+      widths.push_back(column.width_markdown());
+    }
     std::stringstream stream;
-    stream << print_header_as_markdown();
+    stream << print_header_as_markdown(widths);
     const std::size_t number_of_rows_{number_of_rows()};
     for (std::size_t row_index = 0; row_index < number_of_rows_; ++row_index) {
-      stream << std::endl << print_row_as_markdown(row_index);
+      stream << std::endl << print_row_as_markdown(row_index, widths);
     }
     return stream.str();
   }
@@ -90,32 +95,35 @@ private:
     return text;
   }
 
-  std::string print_header_as_markdown() const noexcept {
+  std::string print_header_as_markdown(
+      const std::vector<int64_t>& widths) const noexcept {
     std::stringstream stream;
     stream << "|";
-    for (const Column& column : columns_) {
-      stream
-          << " " << pad_to_length(column.header_bold(), column.width_markdown())
-          << " |";
+    for (std::size_t index = 0; index < columns_.size(); ++index) {
+      stream << " "
+             << pad_to_length(columns_[index].header_bold(), widths[index])
+             << " |";
     }
     stream << std::endl << "|";
-    for (const Column& column : columns_) {
-      stream
-          << " "
-          << pad_to_length(column.alignment_markdown(), column.width_markdown())
-          << " |";
+    for (std::size_t index = 0; index < columns_.size(); ++index) {
+      stream << " "
+             << pad_to_length(
+                    columns_[index].alignment_markdown(), widths[index])
+             << " |";
     }
     return stream.str();
   }
 
-  std::string print_row_as_markdown(const std::size_t index) const noexcept {
+  std::string print_row_as_markdown(
+      const std::size_t index,
+      const std::vector<int64_t>& widths) const noexcept {
     std::string text{"|"};
-    for (const Column& column : columns_) {
-      if (index < column.number_of_rows()) {
-        text +=
-            " " + pad_to_length(column[index], column.width_markdown()) + " |";
+    for (std::size_t column = 0; column < columns_.size(); ++column) {
+      if (index < columns_[column].number_of_rows()) {
+        text += " " + pad_to_length(columns_[column][index], widths[column])
+                + " |";
       } else {
-        text += " " + pad_to_length({}, column.width_markdown()) + " |";
+        text += " " + pad_to_length({}, widths[column]) + " |";
       }
     }
     return text;
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace CatanRanker {
+
+/// \brief Pool of worker threads that execute tasks using work stealing. Each
+/// thread owns a queue of tasks: it executes the most recently submitted task
+/// of its own queue first and, when its own queue is empty, steals the oldest
+/// task of another thread's queue. Threads that are not workers of this pool,
+/// such as the main thread, share one additional queue and help execute tasks
+/// while they wait.
+class TaskScheduler {
+public:
+  /// \brief Create a pool with a total number of threads, including the thread
+  /// that waits for the tasks. A pool with 1 thread executes every task on the
+  /// waiting thread.
+  TaskScheduler(const std::size_t number_of_threads) noexcept
+    : number_of_threads_(std::max(number_of_threads, std::size_t{1})) {
+    for (std::size_t index = 0; index < number_of_threads_; ++index) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t index = 1; index < number_of_threads_; ++index) {
+      workers_.emplace_back([this, index]() { work(index); });
+    }
+  }
+
+  ~TaskScheduler() noexcept {
+    {
+      const std::lock_guard<std::mutex> lock{sleep_mutex_};
+      stop_ = true;
+    }
+    sleep_condition_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  TaskScheduler(const TaskScheduler&) = delete;
+
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  constexpr std::size_t number_of_threads() const noexcept {
+    return number_of_threads_;
+  }
+
+  /// \brief Queue a task. The task is queued on the calling thread's own queue
+  /// so that it is likely to run on the same thread as the task that submitted
+  /// it.
+  void submit(std::function<void()> task) noexcept {
+    Queue& queue{*queues_[current_queue_index()]};
+    {
+      const std::lock_guard<std::mutex> lock{queue.mutex};
+      queue.tasks.push_back(std::move(task));
+    }
+    {
+      const std::lock_guard<std::mutex> lock{sleep_mutex_};
+      ++number_of_queued_tasks_;
+    }
+    sleep_condition_.notify_one();
+  }
+
+  /// \brief Execute queued tasks on the calling thread until a condition is
+  /// satisfied. The condition must become satisfied as a result of executing
+  /// tasks, and the task that satisfies it must then call notify() so that
+  /// the calling thread wakes up if it is sleeping.
+  void wait_until(const std::function<bool()>& condition) noexcept {
+    const std::size_t index{current_queue_index()};
+    while (!condition()) {
+      std::function<void()> task;
+      if (take(index, task)) {
+        task();
+      } else {
+        std::unique_lock<std::mutex> lock{sleep_mutex_};
+        sleep_condition_.wait(lock, [&]() {
+          return number_of_queued_tasks_ > 0 || condition();
+        });
+      }
+    }
+  }
+
+  /// \brief Wake up the threads that wait for a condition to be satisfied.
+  void notify() noexcept {
+    // Locking the mutex ensures that a thread that found the condition
+    // unsatisfied is already waiting.
+    {
+      const std::lock_guard<std::mutex> lock{sleep_mutex_};
+    }
+    sleep_condition_.notify_all();
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+
+    std::deque<std::function<void()>> tasks;
+  };
+
+  /// \brief Identifies the pool and queue owned by the current thread, if the
+  /// current thread is a worker.
+  struct Worker {
+    const TaskScheduler* scheduler{nullptr};
+
+    std::size_t index{0};
+  };
+
+  static Worker& current_worker() noexcept {
+    static thread_local Worker worker;
+    return worker;
+  }
+
+  std::size_t number_of_threads_;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+
+  std::vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+
+  std::condition_variable sleep_condition_;
+
+  std::size_t number_of_queued_tasks_{0};
+
+  bool stop_{false};
+
+  std::size_t current_queue_index() const noexcept {
+    const Worker& worker{current_worker()};
+    if (worker.scheduler == this) {
+      return worker.index;
+    } else {
+      return 0;
+    }
+  }
+
+  /// \brief Take a task from a thread's own queue, or steal one from another
+  /// thread's queue if its own queue is empty.
+  bool take(const std::size_t index, std::function<void()>& task) noexcept {
+    for (std::size_t offset = 0; offset < number_of_threads_; ++offset) {
+      Queue& queue{*queues_[(index + offset) % number_of_threads_]};
+      {
+        const std::lock_guard<std::mutex> lock{queue.mutex};
+        if (queue.tasks.empty()) {
+          continue;
+        }
+        if (offset == 0) {
+          task = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        } else {
+          task = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+      }
+      const std::lock_guard<std::mutex> lock{sleep_mutex_};
+      --number_of_queued_tasks_;
+      return true;
+    }
+    return false;
+  }
+
+  void work(const std::size_t index) noexcept {
+    current_worker() = {this, index};
+    while (true) {
+      std::function<void()> task;
+      if (take(index, task)) {
+        task();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock{sleep_mutex_};
+      sleep_condition_.wait(
+          lock, [this]() { return stop_ || number_of_queued_tasks_ > 0; });
+      if (stop_ && number_of_queued_tasks_ == 0) {
+        return;
+      }
+    }
+  }
+};
+
+/// \brief Directed acyclic graph of tasks. A task is executed once all of the
+/// tasks on which it depends have been executed. If a task throws an
+/// exception, the tasks that have not started yet are skipped and the
+/// exception is rethrown once the graph has finished running.
+class TaskGraph {
+public:
+  TaskGraph() noexcept {}
+
+  TaskGraph(const TaskGraph&) = delete;
+
+  TaskGraph& operator=(const TaskGraph&) = delete;
+
+  /// \brief Add a task that depends on previously added tasks. Returns the
+  /// identifier of the new task.
+  std::size_t add(std::function<void()> function,
+                  const std::vector<std::size_t>& dependencies = {}) noexcept {
+    const std::size_t identifier{tasks_.size()};
+    tasks_.emplace_back();
+    tasks_.back().function = std::move(function);
+    tasks_.back().number_of_dependencies = dependencies.size();
+    for (const std::size_t dependency : dependencies) {
+      tasks_[dependency].dependents.push_back(identifier);
+    }
+    return identifier;
+  }
+
+  std::size_t size() const noexcept {
+    return tasks_.size();
+  }
+
+  /// \brief Execute every task of this graph using a task scheduler. Returns
+  /// once every task has been executed or skipped.
+  void run(TaskScheduler& scheduler) {
+    number_of_remaining_tasks_ = tasks_.size();
+    for (Task& task : tasks_) {
+      task.number_of_remaining_dependencies = task.number_of_dependencies;
+    }
+    for (std::size_t identifier = 0; identifier < tasks_.size(); ++identifier) {
+      if (tasks_[identifier].number_of_dependencies == 0) {
+        scheduler.submit([this, &scheduler, identifier]() {
+          execute(scheduler, identifier);
+        });
+      }
+    }
+    scheduler.wait_until(
+        [this]() { return number_of_remaining_tasks_.load() == 0; });
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+private:
+  struct Task {
+    std::function<void()> function;
+
+    std::vector<std::size_t> dependents;
+
+    std::size_t number_of_dependencies{0};
+
+    std::atomic<std::size_t> number_of_remaining_dependencies{0};
+  };
+
+  std::deque<Task> tasks_;
+
+  std::atomic<std::size_t> number_of_remaining_tasks_{0};
+
+  std::atomic<bool> failed_{false};
+
+  std::mutex exception_mutex_;
+
+  std::exception_ptr exception_;
+
+  void execute(
+      TaskScheduler& scheduler, const std::size_t identifier) noexcept {
+    Task& task{tasks_[identifier]};
+    if (!failed_) {
+      try {
+        task.function();
+      } catch (...) {
+        const std::lock_guard<std::mutex> lock{exception_mutex_};
+        if (!exception_) {
+          exception_ = std::current_exception();
+        }
+        failed_ = true;
+      }
+    }
+    for (const std::size_t dependent : task.dependents) {
+      if (--tasks_[dependent].number_of_remaining_dependencies == 0) {
+        scheduler.submit(
+            [this, &scheduler, dependent]() { execute(scheduler, dependent); });
+      }
+    }
+    // The graph may be destroyed once its last task is done, so only the
+    // scheduler is used afterwards.
+    if (--number_of_remaining_tasks_ == 0) {
+      scheduler.notify();
+    }
+  }
+};
+
+}  // namespace CatanRanker
@@ -6,7 +6,7 @@ namespace CatanRanker {
 
 class TextFileReader : public FileReader {
 public:
-  TextFileReader(const std::experimental::filesystem::path& path) noexcept
+  TextFileReader(const std::experimental::filesystem::path& path)
     : FileReader(path) {
     if (stream_.is_open()) {
       std::string line;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "TextFileWriter.hpp"
+#include "Tracer.hpp"
+
+namespace CatanRanker {
+
+/// \brief Writer of the spans recorded by a tracer as a JSON file in the Chrome
+/// trace event format. Each span is a complete event on the thread on which it
+/// was recorded, and each thread is named after its number.
+class TraceFileWriter : public TextFileWriter {
+public:
+  TraceFileWriter(const std::experimental::filesystem::path& path,
+                  const Tracer& tracer) noexcept
+    : TextFileWriter(path) {
+    line("{");
+    line("  \"displayTimeUnit\": \"ms\",");
+    line("  \"traceEvents\": [");
+    const int64_t number_of_threads{tracer.number_of_threads()};
+    for (int64_t thread = 1; thread <= number_of_threads; ++thread) {
+      line("    {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+           "\"tid\": "
+           + std::to_string(thread) + ", \"args\": {\"name\": \"Thread "
+           + std::to_string(thread) + "\"}},");
+    }
+    const std::vector<Tracer::Event> events{tracer.events()};
+    for (std::size_t index = 0; index < events.size(); ++index) {
+      const Tracer::Event& event{events[index]};
+      line("    {\"name\": \"" + escape(event.name) + "\", \"cat\": \""
+           + escape(event.category) + "\", \"ph\": \"X\", \"ts\": "
+           + std::to_string(event.begin_microseconds) + ", \"dur\": "
+           + std::to_string(event.duration_microseconds)
+           + ", \"pid\": 1, \"tid\": " + std::to_string(event.thread) + "}"
+           + (index + 1 < events.size() ? "," : ""));
+    }
+    line("  ]");
+    line("}");
+  }
+
+private:
+  /// \brief Escape the characters of a string that cannot appear as-is in a
+  /// JSON string.
+  static std::string escape(const std::string& text) noexcept {
+    std::string escaped;
+    for (const char character : text) {
+      if (character == '"' || character == '\\') {
+        escaped += '\\';
+        escaped += character;
+      } else if (static_cast<unsigned char>(character) < 0x20) {
+        escaped += ' ';
+      } else {
+        escaped += character;
+      }
+    }
+    return escaped;
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Base.hpp"
+
+/// \brief Traces a span from this statement to the end of the enclosing scope
+/// using a tracer. The name of the span is an expression that is only
+/// evaluated if the tracer is enabled. If the program is compiled without
+/// CATAN_RANKER_TRACING, this statement compiles to nothing.
+#ifdef CATAN_RANKER_TRACING
+#define CATAN_RANKER_TRACE_SPAN(tracer, category, name)                        \
+  const CatanRanker::Tracer::Span CATAN_RANKER_TRACE_SPAN_VARIABLE(__LINE__) { \
+    tracer, category, [&]() { return std::string{name}; }                      \
+  }
+#define CATAN_RANKER_TRACE_SPAN_VARIABLE(line)                                 \
+  CATAN_RANKER_TRACE_SPAN_CONCATENATE(catan_ranker_trace_span_, line)
+#define CATAN_RANKER_TRACE_SPAN_CONCATENATE(prefix, line) prefix##line
+#else
+#define CATAN_RANKER_TRACE_SPAN(tracer, category, name) static_cast<void>(0)
+#endif
+
+namespace CatanRanker {
+
+/// \brief Records spans of time on every thread in order to export them as a
+/// trace in the Chrome trace event format, which can be viewed with Perfetto
+/// or chrome://tracing. Nothing is recorded if the tracer is disabled.
+class Tracer {
+public:
+  /// \brief Whether the program was compiled with the trace instrumentation.
+#ifdef CATAN_RANKER_TRACING
+  static constexpr bool Available{true};
+#else
+  static constexpr bool Available{false};
+#endif
+
+  /// \brief Span of time recorded on one thread.
+  struct Event {
+    std::string name;
+
+    std::string category;
+
+    int64_t begin_microseconds{0};
+
+    int64_t duration_microseconds{0};
+
+    int64_t thread{0};
+  };
+
+  /// \brief Records a span of time on the current thread from its construction
+  /// to its destruction. Use the CATAN_RANKER_TRACE_SPAN macro rather than
+  /// this class so that spans compile to nothing when tracing is unavailable.
+  class Span {
+  public:
+    template <typename NameFunction>
+    Span(Tracer& tracer, const char* const category,
+         const NameFunction& name) noexcept
+      : tracer_(tracer) {
+      if (tracer_.enabled()) {
+        name_ = name();
+        category_ = category;
+        begin_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~Span() noexcept {
+      if (tracer_.enabled()) {
+        tracer_.record(std::move(name_), std::move(category_), begin_,
+                       std::chrono::steady_clock::now());
+      }
+    }
+
+    Span(const Span&) = delete;
+
+    Span& operator=(const Span&) = delete;
+
+  private:
+    Tracer& tracer_;
+
+    std::string name_;
+
+    std::string category_;
+
+    std::chrono::steady_clock::time_point begin_;
+  };
+
+  Tracer(const bool enabled = false) noexcept
+    : enabled_(Available && enabled),
+      begin_(std::chrono::steady_clock::now()) {}
+
+  Tracer(const Tracer&) = delete;
+
+  Tracer& operator=(const Tracer&) = delete;
+
+  constexpr bool enabled() const noexcept {
+    return enabled_;
+  }
+
+  /// \brief Recorded spans, in the order in which they ended.
+  std::vector<Event> events() const noexcept {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return events_;
+  }
+
+  /// \brief Number of threads on which spans were recorded. Threads are
+  /// numbered from 1 in the order in which they first recorded a span.
+  int64_t number_of_threads() const noexcept {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return static_cast<int64_t>(threads_.size());
+  }
+
+private:
+  bool enabled_{false};
+
+  std::chrono::steady_clock::time_point begin_;
+
+  mutable std::mutex mutex_;
+
+  std::vector<Event> events_;
+
+  std::map<std::thread::id, int64_t> threads_;
+
+  void record(std::string&& name, std::string&& category,
+              const std::chrono::steady_clock::time_point begin,
+              const std::chrono::steady_clock::time_point end) noexcept {
+    Event event;
+    event.name = std::move(name);
+    event.category = std::move(category);
+    event.begin_microseconds = microseconds(begin);
+    event.duration_microseconds = microseconds(end) - event.begin_microseconds;
+    const std::lock_guard<std::mutex> lock{mutex_};
+    event.thread =
+        threads_
+            .insert({std::this_thread::get_id(),
+                     static_cast<int64_t>(threads_.size()) + 1})
+            .first->second;
+    events_.push_back(std::move(event));
+  }
+
+  int64_t microseconds(
+      const std::chrono::steady_clock::time_point time) const noexcept {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - begin_)
+        .count();
+  }
+};
+
+}  // namespace CatanRanker
@@ -0,0 +1,22 @@
+set terminal pngcairo size 1000,750 enhanced font "Verdana,10"
+set output "leaderboard/players/Bob/plots/average_points_vs_game_number.png"
+set title ""
+set grid xtics ytics mxtics mytics
+set key horizontal center top outside
+set ylabel "Average Points per Game"
+set yrange [2:11]
+set ytics mirror out 1.0
+set mytics 10
+set y2label ""
+set y2range [2:11]
+set y2tics mirror in 1.0
+set my2tics 10
+set xlabel "Game Number"
+set xtics nomirror out
+set mxtics 1
+plot \
+  "leaderboard/players/Bob/data/all_games.dat" u 3:8 w lp lw 4 pt 0 ps 1 lt rgb "#0866A5" t "All Games" , \
+  "leaderboard/players/Bob/data/3_4_player_games.dat" u 3:8 w lp lw 2 pt 0 ps 1 lt rgb "#EA772F" t "3-4 Player Games" , \
+  "leaderboard/players/Bob/data/5_6_player_games.dat" u 3:8 w lp lw 2 pt 0 ps 1 lt rgb "#1F9E34" t "5-6 Player Games" , \
+  "leaderboard/players/Bob/data/7_8_player_games.dat" u 3:8 w lp lw 2 pt 0 ps 1 lt rgb "#A3B801" t "7-8 Player Games" , \
+
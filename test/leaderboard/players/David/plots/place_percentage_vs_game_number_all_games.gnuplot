@@ -0,0 +1,21 @@
+set terminal pngcairo size 1000,750 enhanced font "Verdana,10"
+set output "leaderboard/players/David/plots/place_percentage_vs_game_number_all_games.png"
+set title ""
+set grid xtics ytics mxtics mytics
+set key horizontal center top outside
+set ylabel "All Games Place %"
+set yrange [0:100]
+set ytics mirror out 10.0
+set mytics 10
+set y2label ""
+set y2range [0:100]
+set y2tics mirror in 10.0
+set my2tics 10
+set xlabel "Game Number"
+set xtics nomirror out
+set mxtics 1
+plot \
+  "leaderboard/players/David/data/all_games.dat" u 4:9 w lp lw 4 pt 0 ps 1 lt rgb "#FEC53E" t "1st Place" , \
+  "leaderboard/players/David/data/all_games.dat" u 4:10 w lp lw 3 pt 0 ps 1 lt rgb "#B5BBB7" t "2nd Place" , \
+  "leaderboard/players/David/data/all_games.dat" u 4:11 w lp lw 2 pt 0 ps 1 lt rgb "#5B2A2A" t "3rd Place" , \
+
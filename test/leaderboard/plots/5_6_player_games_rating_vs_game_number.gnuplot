@@ -0,0 +1,24 @@
+set terminal pngcairo size 1000,750 enhanced font "Verdana,10"
+set output "leaderboard/plots/5_6_player_games_rating_vs_game_number.png"
+set title ""
+set grid xtics ytics mxtics mytics
+set key horizontal center top outside
+set ylabel "Rating"
+set yrange [900:1100]
+set ytics mirror out
+set mytics 10
+set y2label ""
+set y2range [900:1100]
+set y2tics mirror in
+set my2tics 10
+set xlabel "Game Number"
+set xtics nomirror out
+set mxtics 1
+plot \
+  "leaderboard/data/5_6_player_games/Alice.dat" u 1:3 w lp lw 2 pt 0 ps 1 lt rgb "#EA772F" t "Alice" , \
+  "leaderboard/data/5_6_player_games/Bob.dat" u 1:3 w lp lw 2 pt 0 ps 1 lt rgb "#1F9E34" t "Bob" , \
+  "leaderboard/data/5_6_player_games/Claire.dat" u 1:3 w lp lw 2 pt 0 ps 1 lt rgb "#FEC53E" t "Claire" , \
+  "leaderboard/data/5_6_player_games/David.dat" u 1:3 w lp lw 2 pt 0 ps 1 lt rgb "#A3B801" t "David" , \
+  "leaderboard/data/5_6_player_games/Edith.dat" u 1:3 w lp lw 2 pt 0 ps 1 lt rgb "#B5BBB7" t "Edith" , \
+  "leaderboard/data/5_6_player_games/Francis.dat" u 1:3 w lp lw 2 pt 0 ps 1 lt rgb "#0866A5" t "Francis" , \
+
@@ -0,0 +1,26 @@
+set terminal pngcairo size 1000,750 enhanced font "Verdana,10"
+set output "leaderboard/plots/7_8_player_games_1st_place_percentage_vs_game_number.png"
+set title ""
+set grid xtics ytics mxtics mytics
+set key horizontal center top outside
+set ylabel "7-8 Player Games 1st Place %"
+set yrange [0:100]
+set ytics mirror out 10.0
+set mytics 10
+set y2label ""
+set y2range [0:100]
+set y2tics mirror in 10.0
+set my2tics 10
+set xlabel "Game Number"
+set xtics nomirror out
+set mxtics 1
+plot \
+  "leaderboard/data/7_8_player_games/Alice.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#EA772F" t "Alice" , \
+  "leaderboard/data/7_8_player_games/Bob.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#1F9E34" t "Bob" , \
+  "leaderboard/data/7_8_player_games/Claire.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#FEC53E" t "Claire" , \
+  "leaderboard/data/7_8_player_games/David.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#A3B801" t "David" , \
+  "leaderboard/data/7_8_player_games/Edith.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#B5BBB7" t "Edith" , \
+  "leaderboard/data/7_8_player_games/Francis.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#0866A5" t "Francis" , \
+  "leaderboard/data/7_8_player_games/Gabby.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#9066BA" t "Gabby" , \
+  "leaderboard/data/7_8_player_games/Hugo.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#D9D295" t "Hugo" , \
+
@@ -0,0 +1,30 @@
+set terminal pngcairo size 1000,750 enhanced font "Verdana,10"
+set output "leaderboard_generated/plots/5_6_player_games_1st_place_percentage_vs_game_number.png"
+set title ""
+set grid xtics ytics mxtics mytics
+set key horizontal center top outside
+set ylabel "5-6 Player Games 1st Place %"
+set yrange [0:100]
+set ytics mirror out 10.0
+set mytics 10
+set y2label ""
+set y2range [0:100]
+set y2tics mirror in 10.0
+set my2tics 10
+set xlabel "Game Number"
+set xtics nomirror out
+set mxtics 1
+plot \
+  "leaderboard_generated/data/5_6_player_games/Playera.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#E0B568" t "Playera" , \
+  "leaderboard_generated/data/5_6_player_games/Playerb.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#1F9E34" t "Playerb" , \
+  "leaderboard_generated/data/5_6_player_games/Playerd.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#5B2A2A" t "Playerd" , \
+  "leaderboard_generated/data/5_6_player_games/Playere.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#EA772F" t "Playere" , \
+  "leaderboard_generated/data/5_6_player_games/Playerf.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#FEC53E" t "Playerf" , \
+  "leaderboard_generated/data/5_6_player_games/Playeri.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#0866A5" t "Playeri" , \
+  "leaderboard_generated/data/5_6_player_games/Playerj.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#B5BBB7" t "Playerj" , \
+  "leaderboard_generated/data/5_6_player_games/Playerk.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#7FCFF5" t "Playerk" , \
+  "leaderboard_generated/data/5_6_player_games/Playerl.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#A3B801" t "Playerl" , \
+  "leaderboard_generated/data/5_6_player_games/Playerm.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#D9D295" t "Playerm" , \
+  "leaderboard_generated/data/5_6_player_games/Playern.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#CC0000" t "Playern" , \
+  "leaderboard_generated/data/5_6_player_games/Playerq.dat" u 1:5 w lp lw 2 pt 0 ps 1 lt rgb "#9066BA" t "Playerq" , \
+